@@ -1,19 +1,29 @@
 #pragma once
 
+#include <atomic>
+#include <concepts>
 #include <mutex>
 #include <unordered_map>
 #include "SequenceBarrier.hpp"
 #include "../sequence/Sequence.hpp"
 #include "../sequencer/Sequencer.hpp"
 #include "../exception/AlertException.hpp"
+#include "../exception/TimeoutException.hpp"
+#include "../common/Util.hpp"
 #include "../wait_strategy/WaitStrategyType.hpp"
 #include "../wait_strategy/AdaptiveWaitStrategy.hpp"
 #include "../sequence/SequenceGroupForSingleThread.hpp"
 #include "../wait_strategy/YieldingWaitStrategy.hpp"
+#include "../wait_strategy/BlockingWaitStrategy.hpp"
+#include "../wait_strategy/PhasedBackoffWaitStrategy.hpp"
+#include "../wait_strategy/SelfTuningWaitStrategy.hpp"
+#include "../common/BackoffPolicy.hpp"
 
 /**
  * each processor will have a single corresponding sequence barrier. The purpose is to optimize cache
  * values within sequence barrier for each processor and to avoid race conditions.
+ * SequencerType defaults to the Sequencer interface. Pass the concrete (final) sequencer type to call
+ * get_highest_published_sequence without going through the vtable.
  */
 namespace disruptor {
     template<WaitStrategyType T, size_t NUMBER_DEPENDENT_SEQUENCES>
@@ -22,17 +32,54 @@ namespace disruptor {
     template<size_t NUMBER_DEPENDENT_SEQUENCES>
     struct WaitStrategySelector<WaitStrategyType::ADAPTIVE, NUMBER_DEPENDENT_SEQUENCES> {
         using type = AdaptiveWaitStrategy<NUMBER_DEPENDENT_SEQUENCES>;
+
+        static type create(Sequencer &, const BackoffPolicy &) {
+            return type{};
+        }
     };
 
     template<size_t NUMBER_DEPENDENT_SEQUENCES>
     struct WaitStrategySelector<WaitStrategyType::YIELD, NUMBER_DEPENDENT_SEQUENCES> {
         using type = YieldingWaitStrategy<NUMBER_DEPENDENT_SEQUENCES>;
+
+        static type create(Sequencer &, const BackoffPolicy &) {
+            return type{};
+        }
     };
 
-    template<WaitStrategyType T, size_t NUMBER_DEPENDENT_SEQUENCES>
+    template<size_t NUMBER_DEPENDENT_SEQUENCES>
+    struct WaitStrategySelector<WaitStrategyType::BLOCKING, NUMBER_DEPENDENT_SEQUENCES> {
+        using type = BlockingWaitStrategy<NUMBER_DEPENDENT_SEQUENCES>;
+
+        static type create(Sequencer &sequencer, const BackoffPolicy &) {
+            return type{sequencer};
+        }
+    };
+
+    template<size_t NUMBER_DEPENDENT_SEQUENCES>
+    struct WaitStrategySelector<WaitStrategyType::PHASED_BACKOFF, NUMBER_DEPENDENT_SEQUENCES> {
+        using type = PhasedBackoffWaitStrategy<NUMBER_DEPENDENT_SEQUENCES>;
+
+        static type create(Sequencer &sequencer, const BackoffPolicy &backoff_policy) {
+            return type{backoff_policy, sequencer};
+        }
+    };
+
+    template<size_t NUMBER_DEPENDENT_SEQUENCES>
+    struct WaitStrategySelector<WaitStrategyType::SELF_TUNING, NUMBER_DEPENDENT_SEQUENCES> {
+        using type = SelfTuningWaitStrategy<NUMBER_DEPENDENT_SEQUENCES>;
+
+        static type create(Sequencer &, const BackoffPolicy &backoff_policy) {
+            return type{backoff_policy};
+        }
+    };
+
+    template<WaitStrategyType T, size_t NUMBER_DEPENDENT_SEQUENCES, typename SequencerType = Sequencer>
+        requires std::derived_from<SequencerType, Sequencer>
     class ProcessingSequenceBarrier final : public SequenceBarrier {
         alignas(CACHE_LINE_SIZE) const char padding_1[CACHE_LINE_SIZE] = {};
-        using Strategy = typename WaitStrategySelector<T, NUMBER_DEPENDENT_SEQUENCES>::type;
+        using Selector = WaitStrategySelector<T, NUMBER_DEPENDENT_SEQUENCES>;
+        using Strategy = typename Selector::type;
         Strategy wait_strategy;
         const bool direct_publisher_event_listener; // listen directly to events from the publisher, not from any dependent processor
         const char padding_2[CACHE_LINE_SIZE * 2] = {};
@@ -40,11 +87,11 @@ namespace disruptor {
         alignas(CACHE_LINE_SIZE) SequenceGroupForSingleThread<NUMBER_DEPENDENT_SEQUENCES> dependent_sequences;
 
         alignas(CACHE_LINE_SIZE) const char padding_3[CACHE_LINE_SIZE] = {};
-        bool alerted;
-        const char padding_4[CACHE_LINE_SIZE - sizeof(bool)] = {};
+        std::atomic<bool> alerted;
+        const char padding_4[CACHE_LINE_SIZE - sizeof(std::atomic<bool>)] = {};
         const char padding_5[CACHE_LINE_SIZE] = {};
 
-        Sequencer &sequencer;
+        SequencerType &sequencer;
 
         // allow single thread access to the sequence barrier
         bool same_thread() {
@@ -55,50 +102,88 @@ namespace disruptor {
         ProcessingSequenceBarrier(
             const bool direct_publisher_event_listener,
             std::initializer_list<std::reference_wrapper<Sequence> > dependent_sequences,
-            Sequencer &sequencer)
-            : direct_publisher_event_listener(direct_publisher_event_listener),
+            SequencerType &sequencer,
+            const BackoffPolicy &backoff_policy = BackoffPolicy{})
+            : wait_strategy(Selector::create(sequencer, backoff_policy)),
+              direct_publisher_event_listener(direct_publisher_event_listener),
               dependent_sequences(dependent_sequences),
               alerted(false),
               sequencer(sequencer) {
         }
 
+        ~ProcessingSequenceBarrier() override {
+            SequenceBarrierThreadAssertion::forget(this);
+        }
+
         // wait for a specific sequence to be ready for processing
-        size_t wait_for(size_t sequence) override {
+        size_t wait_for(const size_t sequence) override {
+            return wait_for(sequence, NO_DEADLINE);
+        }
+
+        // same as above, but throws TimeoutException if nothing arrives before the deadline
+        size_t wait_for(const size_t sequence, const Deadline deadline) override {
+            const WaitResult result = try_wait_for(sequence, deadline);
+            if (result.status == WaitStatus::ALERTED) [[unlikely]] {
+                throw_or_abort(AlertException());
+            }
+            if (result.status == WaitStatus::TIMEOUT) [[unlikely]] {
+                throw_or_abort(TimeoutException());
+            }
+            return result.available_sequence;
+        }
+
+        // never throws, an alert or an expired deadline is returned in the status
+        [[gnu::hot]] WaitResult try_wait_for(const size_t sequence, const Deadline deadline) override {
             assert(same_thread() && "Accessed by two threads");
-            check_alert();
+            if (alerted.load(std::memory_order_acquire)) [[unlikely]] {
+                return {sequence - 1, WaitStatus::ALERTED};
+            }
 
-            const size_t available_sequence = wait_strategy.wait_for(sequence, dependent_sequences, *this);
-            if (available_sequence < sequence) {
-                return available_sequence;
+            const size_t available_sequence = wait_strategy.wait_for(sequence, dependent_sequences, *this, deadline);
+            if (available_sequence < sequence) [[unlikely]] {
+                if (alerted.load(std::memory_order_acquire)) {
+                    return {available_sequence, WaitStatus::ALERTED};
+                }
+                if (Util::is_expired(deadline)) {
+                    return {available_sequence, WaitStatus::TIMEOUT};
+                }
+                return {available_sequence, WaitStatus::AVAILABLE};
             }
 
             if (direct_publisher_event_listener) {
                 // listen directly from the publisher
                 // single producer: directly returns "available_sequence"
                 // multi producer: returns the highest contiguous sequence that has been published
-                return sequencer.get_highest_published_sequence(sequence, available_sequence);
+                return {sequencer.get_highest_published_sequence(sequence, available_sequence), WaitStatus::AVAILABLE};
             }
 
             // wait after other processors
             // this sequence is guaranteed to have been published
-            return available_sequence;
+            return {available_sequence, WaitStatus::AVAILABLE};
+        }
+
+        // tune the wait strategy, e.g. PhasedBackoffWaitStrategy::set_backoff_policy
+        [[nodiscard]] Strategy &get_wait_strategy() {
+            return wait_strategy;
         }
 
         [[nodiscard]] bool is_alerted() const override {
-            return alerted;
+            return alerted.load(std::memory_order_acquire);
         }
 
+        // may be called from any thread
         void alert() override {
-            alerted = true;
+            alerted.store(true, std::memory_order_release);
+            wait_strategy.signal_all_when_blocking();
         }
 
         void clear_alert() override {
-            alerted = false;
+            alerted.store(false, std::memory_order_release);
         }
 
         [[gnu::hot]] void check_alert() const override {
-            if (alerted) [[unlikely]]{
-                throw AlertException();
+            if (alerted.load(std::memory_order_acquire)) [[unlikely]] {
+                throw_or_abort(AlertException());
             }
         }
 
@@ -120,6 +205,12 @@ namespace disruptor {
 
                 return SEQUENCE_BARRIERS[sequence_barrier] == current_thread;
             }
+
+            // a barrier created later at the same address may be used by another thread
+            static void forget(ProcessingSequenceBarrier *sequence_barrier) {
+                std::lock_guard lock(producers_mutex);
+                SEQUENCE_BARRIERS.erase(sequence_barrier);
+            }
         };
     };
 }
@@ -1,7 +1,24 @@
 #pragma once
 
+#include "../common/Common.hpp"
+#include "../exception/AlertException.hpp"
+#include "../exception/TimeoutException.hpp"
+
 namespace disruptor
 {
+    enum class WaitStatus
+    {
+        AVAILABLE,
+        ALERTED,
+        TIMEOUT,
+    };
+
+    struct WaitResult
+    {
+        size_t available_sequence;
+        WaitStatus status;
+    };
+
     /**
      * Track the required processor for the processors to process
      */
@@ -19,6 +36,49 @@ namespace disruptor
          */
         [[nodiscard]] virtual size_t wait_for(size_t sequence) = 0;
 
+        /**
+         * Wait for the given sequence to be available for consumption, giving up once the deadline has passed.
+         *
+         * @param sequence to wait for
+         * @param deadline after which waiting stops
+         * @return the sequence up to which is available
+         * @throws AlertException if a status change has occurred for the Disruptor
+         * @throws TimeoutException if no event became available before the deadline
+         */
+        [[nodiscard]] virtual size_t wait_for(size_t sequence, Deadline deadline) = 0;
+
+        /**
+         * Same as wait_for, but reports an alert or an expired deadline in the status instead of throwing, so it can
+         * be used in builds without exceptions. available_sequence is only meaningful with WaitStatus::AVAILABLE.
+         * The default implementation translates the exceptions of wait_for.
+         *
+         * @param sequence to wait for
+         * @param deadline after which waiting stops, NO_DEADLINE to wait forever
+         */
+        [[nodiscard]] virtual WaitResult try_wait_for(const size_t sequence, const Deadline deadline)
+        {
+#if defined(__cpp_exceptions)
+            try
+            {
+                return {deadline == NO_DEADLINE ? wait_for(sequence) : wait_for(sequence, deadline), WaitStatus::AVAILABLE};
+            }
+            catch (const AlertException &)
+            {
+                return {0, WaitStatus::ALERTED};
+            }
+            catch (const TimeoutException &)
+            {
+                return {0, WaitStatus::TIMEOUT};
+            }
+#else
+            if (is_alerted())
+            {
+                return {0, WaitStatus::ALERTED};
+            }
+            return {deadline == NO_DEADLINE ? wait_for(sequence) : wait_for(sequence, deadline), WaitStatus::AVAILABLE};
+#endif
+        }
+
         /**
          * The current alert status for the barrier.
          *
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <chrono>
+
+namespace disruptor {
+    enum class ParkMode {
+        SLEEP, // sleep for "park_duration" and check again
+        PRECISE_SLEEP, // clock_nanosleep for "park_duration" with the thread's timer slack lowered to "timer_slack"
+        BLOCK, // hand off to the sequencer's BlockingSignal, "park_duration" bounds each park (consumers only)
+    };
+
+    /**
+     * Spin -> yield -> park budget used while waiting for a sequence.
+     * The defaults are the historical constants of Util::adaptive_wait.
+     */
+    struct BackoffPolicy {
+        int spin_tries = 100;
+        int yield_tries = 10;
+        std::chrono::nanoseconds park_duration{1};
+        ParkMode park_mode = ParkMode::SLEEP;
+        // Linux defaults to 50us of slack, which is what a 1ns sleep_for really costs
+        std::chrono::nanoseconds timer_slack{1};
+    };
+}
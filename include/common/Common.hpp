@@ -1,5 +1,31 @@
 #pragma once
 
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <utility>
+
 namespace disruptor {
     inline constexpr size_t CACHE_LINE_SIZE = 64;
-}
\ No newline at end of file
+
+    // buffer size template argument for rings whose capacity is only known at startup
+    inline constexpr size_t DYNAMIC_SIZE = 0;
+
+    // point in time after which a waiting consumer gives up, NO_DEADLINE waits forever
+    using Deadline = std::chrono::steady_clock::time_point;
+    inline constexpr Deadline NO_DEADLINE = Deadline::max();
+
+    /**
+     * throw "exception", or abort when exceptions are disabled (-fno-exceptions).
+     * Such builds stop processors through the status returned by SequenceBarrier::try_wait_for instead.
+     */
+    template<typename Exception>
+    [[noreturn]] void throw_or_abort(Exception &&exception) {
+#if defined(__cpp_exceptions)
+        throw std::forward<Exception>(exception);
+#else
+        static_cast<void>(exception);
+        std::abort();
+#endif
+    }
+}
@@ -0,0 +1,115 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__AVX512F__) || defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+/**
+ * Vector helpers, the instruction set is chosen at compile time (-march=native in Release):
+ * AVX-512 compares 16 words (or gathers 8 pointers) per instruction, AVX2 compares 8, otherwise a scalar loop.
+ */
+namespace disruptor {
+    class Simd {
+    public:
+#if defined(__AVX512F__)
+        static constexpr const char *INSTRUCTION_SET = "AVX-512";
+#elif defined(__AVX2__)
+        static constexpr const char *INSTRUCTION_SET = "AVX2";
+#else
+        static constexpr const char *INSTRUCTION_SET = "scalar";
+#endif
+
+        // index of the first of the "count" words that is not "value", "count" when they all are
+        // the words may be written concurrently (the multi-producer availability flags): each lane of a vector load
+        // is an aligned 32-bit read, which x86 never tears, so a changing word is seen either old or new
+        [[gnu::hot]] [[nodiscard]] static size_t find_first_not_equal(const uint32_t *words, const size_t count,
+                                                                      const uint32_t value) noexcept {
+            size_t i = 0;
+#if defined(__AVX512F__)
+            const __m512i expected = _mm512_set1_epi32(static_cast<int>(value));
+            for (; i + 16 <= count; i += 16) {
+                const __m512i loaded = _mm512_loadu_si512(words + i);
+                const __mmask16 different = _mm512_cmpneq_epu32_mask(loaded, expected);
+                if (different != 0) {
+                    return i + __builtin_ctz(different);
+                }
+            }
+#elif defined(__AVX2__)
+            const __m256i expected = _mm256_set1_epi32(static_cast<int>(value));
+            for (; i + 8 <= count; i += 8) {
+                const __m256i loaded = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(words + i));
+                const auto equal = static_cast<unsigned>(
+                    _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(loaded, expected))));
+                if (equal != 0xFF) {
+                    return i + __builtin_ctz(~equal);
+                }
+            }
+#endif
+            for (; i < count; ++i) {
+                if (words[i] != value) {
+                    return i;
+                }
+            }
+            return count;
+        }
+
+        // below this many pointers a gather is slower than plain loads (see test_gating_min in main.cpp). AVX2 gathers
+        // 4 lanes and never beat plain loads there, so only AVX-512 gathers
+        static constexpr size_t GATHER_THRESHOLD = 16;
+
+        /**
+         * Minimum of the "count" words that "values" point to, gathered straight from the scattered (padded) Sequences.
+         * "min_index" receives the position of the first minimum. Plain loads: callers add the acquire fence.
+         */
+        [[gnu::hot]] [[nodiscard]] static size_t min_of_pointed(const size_t *const *values, const size_t count,
+                                                               size_t &min_index) noexcept {
+            size_t minimum = SIZE_MAX;
+            min_index = 0;
+            size_t i = 0;
+#if defined(__AVX512F__)
+            if (count >= GATHER_THRESHOLD) {
+                __m512i lane_min = _mm512_set1_epi64(-1);
+                __m512i lane_min_index = _mm512_setzero_si512();
+                __m512i lane_index = _mm512_setr_epi64(0, 1, 2, 3, 4, 5, 6, 7);
+                const __m512i step = _mm512_set1_epi64(8);
+                for (; i + 8 <= count; i += 8) {
+                    const __m512i addresses = _mm512_loadu_si512(values + i);
+                    const __m512i loaded = _mm512_i64gather_epi64(addresses, nullptr, 1);
+                    const __mmask8 lower = _mm512_cmplt_epu64_mask(loaded, lane_min);
+                    lane_min = _mm512_mask_mov_epi64(lane_min, lower, loaded);
+                    lane_min_index = _mm512_mask_mov_epi64(lane_min_index, lower, lane_index);
+                    lane_index = _mm512_add_epi64(lane_index, step);
+                }
+                alignas(64) size_t mins[8];
+                alignas(64) size_t indexes[8];
+                _mm512_store_si512(mins, lane_min);
+                _mm512_store_si512(indexes, lane_min_index);
+                reduce_lanes(mins, indexes, 8, minimum, min_index);
+            }
+#endif
+            for (; i < count; ++i) {
+                const size_t value = *values[i];
+                if (value < minimum) {
+                    minimum = value;
+                    min_index = i;
+                }
+            }
+            return minimum;
+        }
+
+    private:
+        // smallest lane value, the lowest index among equal ones
+        static void reduce_lanes(const size_t *mins, const size_t *indexes, const size_t lanes, size_t &minimum,
+                                 size_t &min_index) noexcept {
+            for (size_t lane = 0; lane < lanes; ++lane) {
+                if (mins[lane] < minimum || (mins[lane] == minimum && indexes[lane] < min_index)) {
+                    minimum = mins[lane];
+                    min_index = indexes[lane];
+                }
+            }
+        }
+    };
+}
@@ -4,6 +4,16 @@
 #include <cstdint>
 #include <chrono>
 #include <condition_variable>
+#include <algorithm>
+#include <thread>
+#include <ctime>
+
+#if defined(__linux__)
+#include <sys/prctl.h>
+#endif
+
+#include "Common.hpp"
+#include "BackoffPolicy.hpp"
 
 namespace disruptor {
     class Util {
@@ -11,7 +21,7 @@ namespace disruptor {
         [[gnu::pure]]
         static int log_2(const int value) {
             if (value < 1) {
-                throw std::invalid_argument("value must be a positive number");
+                throw_or_abort(std::invalid_argument("value must be a positive number"));
             }
             return 31 - __builtin_clz(value);
         }
@@ -90,23 +100,79 @@ namespace disruptor {
         }
 
 
+        // only reads the clock when a deadline has actually been set
+        [[nodiscard]] static bool is_expired(const Deadline deadline) noexcept {
+            return deadline != NO_DEADLINE && std::chrono::steady_clock::now() >= deadline;
+        }
+
+
+        // time left before the deadline, never more than "upper_bound" and never negative
+        [[nodiscard]] static std::chrono::nanoseconds time_until(const Deadline deadline,
+                                                                 const std::chrono::nanoseconds upper_bound) noexcept {
+            if (deadline == NO_DEADLINE) {
+                return upper_bound;
+            }
+            const auto remaining = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                deadline - std::chrono::steady_clock::now());
+            return std::clamp(remaining, std::chrono::nanoseconds(0), upper_bound);
+        }
+
+
         [[gnu::hot]] static void adaptive_wait(int &wait_counter) noexcept {
-            static constexpr int SPIN_TRIES = 100;
-            static constexpr int YIELD_TRIES = 10;
-            static constexpr auto PARK_DURATION = std::chrono::nanoseconds(1);
+            static constexpr BackoffPolicy DEFAULT_POLICY{};
+            adaptive_wait(wait_counter, DEFAULT_POLICY);
+        }
+
 
-            if (wait_counter < SPIN_TRIES) [[likely]] {
+        [[gnu::hot]] static void adaptive_wait(int &wait_counter, const BackoffPolicy &policy) noexcept {
+            if (wait_counter < policy.spin_tries) [[likely]] {
                 // Phase 1: Spin-wait (no context switch)
                 cpu_pause(); // x86 PAUSE instruction
                 wait_counter++;
-            } else if (wait_counter < SPIN_TRIES + YIELD_TRIES) [[likely]] {
+            } else if (wait_counter < policy.spin_tries + policy.yield_tries) [[likely]] {
                 // Phase 2: Yield (light context switch)
                 std::this_thread::yield();
                 wait_counter++;
             } else [[unlikely]] {
-                std::this_thread::sleep_for(PARK_DURATION);
-                wait_counter = SPIN_TRIES;
+                if (policy.park_mode == ParkMode::PRECISE_SLEEP) {
+                    precise_park(policy.park_duration, policy.timer_slack);
+                } else {
+                    std::this_thread::sleep_for(policy.park_duration);
+                }
+                wait_counter = policy.spin_tries;
             }
         }
+
+
+        // lower the calling thread's timer slack, only issues the prctl when the value changes
+        static void set_thread_timer_slack(const std::chrono::nanoseconds timer_slack) noexcept {
+#if defined(__linux__)
+            thread_local long applied_timer_slack = 0;
+            const long requested_timer_slack = std::max<long>(1, static_cast<long>(timer_slack.count()));
+            if (applied_timer_slack != requested_timer_slack) [[unlikely]] {
+                if (prctl(PR_SET_TIMERSLACK, requested_timer_slack, 0, 0, 0) == 0) {
+                    applied_timer_slack = requested_timer_slack;
+                }
+            }
+#endif
+        }
+
+
+        // sleep with a bounded wake-up error: the kernel may only round the expiry up by "timer_slack"
+        static void precise_park(const std::chrono::nanoseconds duration,
+                                 const std::chrono::nanoseconds timer_slack) noexcept {
+#if defined(__linux__)
+            set_thread_timer_slack(timer_slack);
+
+            const auto seconds = std::chrono::duration_cast<std::chrono::seconds>(duration);
+            const timespec request{
+                static_cast<time_t>(seconds.count()),
+                static_cast<long>((duration - seconds).count())
+            };
+            clock_nanosleep(CLOCK_MONOTONIC, 0, &request, nullptr);
+#else
+            std::this_thread::sleep_for(duration);
+#endif
+        }
     };
 }
@@ -0,0 +1,26 @@
+#pragma once
+#include <exception>
+#include <string>
+
+namespace disruptor
+{
+
+    /**
+     * Used to notify EventProcessors that no event arrived at a SequenceBarrier before the deadline.
+     */
+    class TimeoutException : public std::exception
+    {
+    private:
+        std::string message;
+
+    public:
+        TimeoutException() : message("Wait timed out") {}
+        explicit TimeoutException(const std::string &customMessage) : message(customMessage) {}
+
+        const char *what() const noexcept override
+        {
+            return message.c_str();
+        }
+    };
+
+}
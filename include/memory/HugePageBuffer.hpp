@@ -0,0 +1,174 @@
+#pragma once
+
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+#include <iostream>
+#include <new>
+#include <utility>
+
+#if defined(__linux__)
+#include <linux/mman.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#include "../common/Common.hpp"
+
+/**
+ * Fixed size array of T allocated outside the object, with its own mapping so large rings neither live on the stack
+ * nor pay a TLB miss every 4KB.
+ * TRANSPARENT: normal pages advised with MADV_HUGEPAGE, the kernel backs them with 2MB pages when it can.
+ * HUGE_2MB / HUGE_1GB: MAP_HUGETLB from the reserved pool (vm.nr_hugepages), falls back to TRANSPARENT with a warning
+ * when the pool is empty.
+ * The whole mapping is faulted in when it is created, before the slots are constructed: the first lap of the ring does
+ * not take page faults and the slots are not faulted in one 4KB page at a time. Being faulted in by the constructing
+ * thread, the pages follow its memory policy (NumaAllocation::make_on_node binds it to the node).
+ */
+namespace disruptor {
+    enum class PageSize {
+        DEFAULT,
+        TRANSPARENT,
+        HUGE_2MB,
+        HUGE_1GB,
+    };
+
+    template<typename T>
+    class HugePageBuffer final {
+        T *slots = nullptr;
+        size_t count = 0;
+        size_t mapped_size = 0;
+
+        [[nodiscard]] static size_t round_up(const size_t size, const size_t page) {
+            return (size + page - 1) / page * page;
+        }
+
+        void map(const PageSize page_size) {
+#if defined(__linux__)
+            const size_t bytes = sizeof(T) * count;
+            void *memory = MAP_FAILED;
+
+            if (page_size == PageSize::HUGE_2MB || page_size == PageSize::HUGE_1GB) {
+                const bool giant = page_size == PageSize::HUGE_1GB;
+                mapped_size = round_up(bytes, giant ? 1UL << 30 : 1UL << 21);
+                memory = mmap(nullptr, mapped_size, PROT_READ | PROT_WRITE,
+                              MAP_PRIVATE | MAP_ANONYMOUS | MAP_POPULATE | MAP_HUGETLB
+                              | (giant ? MAP_HUGE_1GB : MAP_HUGE_2MB), -1, 0);
+                if (memory == MAP_FAILED) {
+                    std::cerr << "WARNING: cannot map " << mapped_size << " bytes of huge pages (" << std::strerror(errno)
+                            << "), using transparent huge pages" << std::endl;
+                }
+            }
+
+            if (memory == MAP_FAILED) {
+                mapped_size = round_up(bytes, static_cast<size_t>(sysconf(_SC_PAGESIZE)));
+                memory = mmap(nullptr, mapped_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+                if (memory == MAP_FAILED) {
+                    throw_or_abort(std::bad_alloc());
+                }
+                if (page_size != PageSize::DEFAULT) {
+                    // only a hint, THP may be disabled system wide
+                    madvise(memory, mapped_size, MADV_HUGEPAGE);
+                }
+#if defined(MADV_POPULATE_WRITE)
+                // populated after the THP advice so it can be backed by huge pages (no MAP_POPULATE here). Kernels
+                // before 5.14 reject it, the construction of the slots faults the pages in instead
+                madvise(memory, mapped_size, MADV_POPULATE_WRITE);
+#endif
+            }
+            slots = static_cast<T *>(memory);
+#else
+            slots = static_cast<T *>(::operator new(sizeof(T) * count, std::align_val_t{alignof(T)}));
+#endif
+        }
+
+        void unmap() noexcept {
+#if defined(__linux__)
+            munmap(slots, mapped_size);
+#else
+            ::operator delete(slots, std::align_val_t{alignof(T)});
+#endif
+            slots = nullptr;
+        }
+
+    public:
+        /**
+         * @param factory called once per slot, in order, the result is constructed in place.
+         */
+        template<typename Factory>
+        HugePageBuffer(const size_t count, const PageSize page_size, Factory &&factory) : count(count) {
+            static_assert(alignof(T) <= 4096, "page aligned memory cannot satisfy this alignment");
+            map(page_size);
+
+            size_t constructed = 0;
+#if defined(__cpp_exceptions)
+            try {
+#endif
+                for (; constructed < count; ++constructed) {
+                    new(&slots[constructed]) T(factory());
+                }
+#if defined(__cpp_exceptions)
+            } catch (...) {
+                for (size_t i = 0; i < constructed; ++i) {
+                    slots[i].~T();
+                }
+                unmap();
+                throw;
+            }
+#endif
+        }
+
+        ~HugePageBuffer() {
+            if (slots == nullptr) {
+                return;
+            }
+            for (size_t i = 0; i < count; ++i) {
+                slots[i].~T();
+            }
+            unmap();
+        }
+
+        HugePageBuffer(const HugePageBuffer &) = delete;
+
+        HugePageBuffer &operator=(const HugePageBuffer &) = delete;
+
+        HugePageBuffer(HugePageBuffer &&other) noexcept
+            : slots(std::exchange(other.slots, nullptr)), count(other.count), mapped_size(other.mapped_size) {
+        }
+
+        HugePageBuffer &operator=(HugePageBuffer &&) = delete;
+
+        [[gnu::hot]] [[nodiscard]] T &operator[](const size_t index) noexcept {
+            return slots[index];
+        }
+
+        [[gnu::hot]] [[nodiscard]] const T &operator[](const size_t index) const noexcept {
+            return slots[index];
+        }
+
+        [[nodiscard]] T *begin() noexcept {
+            return slots;
+        }
+
+        [[nodiscard]] T *end() noexcept {
+            return slots + count;
+        }
+
+        [[nodiscard]] const T *begin() const noexcept {
+            return slots;
+        }
+
+        [[nodiscard]] const T *end() const noexcept {
+            return slots + count;
+        }
+
+        [[nodiscard]] size_t size() const noexcept {
+            return count;
+        }
+
+        // bytes actually mapped, a multiple of the page size in use
+        [[nodiscard]] size_t get_mapped_size() const noexcept {
+            return mapped_size;
+        }
+    };
+}
@@ -0,0 +1,226 @@
+#pragma once
+
+#include <cerrno>
+#include <cstring>
+#include <exception>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#if defined(__linux__)
+#include <linux/mempolicy.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include "../thread/CpuTopology.hpp"
+#include "../thread/ThreadFactory.hpp"
+
+/**
+ * Construct a disruptor object (RingBuffer, sequencer, BatchEventProcessor, ...) in memory that lives on a chosen NUMA
+ * node. Everything the object stores inline lands there too: ring entries, the multi producer availability buffer,
+ * a processor's Sequence. So do the mappings it makes while it is constructed (the slots of a DYNAMIC_SIZE ring, the
+ * availability flags of a DYNAMIC_SIZE multi producer sequencer): HugePageBuffer faults them in right away.
+ * BIND: mbind the pages to the node, then construct on the calling thread with its memory policy bound to the node.
+ * FIRST_TOUCH: touch every page and construct from a thread pinned to the node's cpus, the kernel places each page
+ * where it is first written. A node without cpus (unknown or offline) is rejected: the thread could not be pinned and
+ * the pages would land wherever the scheduler runs it.
+ */
+namespace disruptor {
+    enum class NumaPlacement {
+        BIND,
+        FIRST_TOUCH,
+    };
+
+    struct NumaPolicy {
+        int node = 0;
+        NumaPlacement placement = NumaPlacement::BIND;
+    };
+
+    template<typename T>
+    class NumaDeleter {
+        size_t mapped_size = 0;
+
+    public:
+        NumaDeleter() = default;
+
+        explicit NumaDeleter(const size_t mapped_size) : mapped_size(mapped_size) {
+        }
+
+        void operator()(T *object) const {
+#if defined(__linux__)
+            object->~T();
+            munmap(object, mapped_size);
+#else
+            delete object;
+#endif
+        }
+    };
+
+    template<typename T>
+    using NumaUniquePtr = std::unique_ptr<T, NumaDeleter<T> >;
+
+    class NumaAllocation {
+#if defined(__linux__)
+        static constexpr size_t NODE_MASK_WORDS = 4;
+        static constexpr size_t BITS_PER_WORD = sizeof(unsigned long) * 8;
+
+        static bool make_node_mask(const int node, unsigned long (&node_mask)[NODE_MASK_WORDS]) {
+            if (node < 0 || static_cast<size_t>(node) >= NODE_MASK_WORDS * BITS_PER_WORD) {
+                std::cerr << "WARNING: NUMA node " << node << " out of range" << std::endl;
+                return false;
+            }
+            node_mask[node / BITS_PER_WORD] = 1UL << (node % BITS_PER_WORD);
+            return true;
+        }
+
+        // binds the pages the calling thread allocates to "node" while in scope, then restores its previous policy
+        class ThreadNodeBinding {
+            int previous_mode = MPOL_DEFAULT;
+            unsigned long previous_mask[NODE_MASK_WORDS] = {};
+            bool bound = false;
+
+        public:
+            explicit ThreadNodeBinding(const int node) {
+                unsigned long node_mask[NODE_MASK_WORDS] = {};
+                if (!make_node_mask(node, node_mask)
+                    || syscall(SYS_get_mempolicy, &previous_mode, previous_mask, NODE_MASK_WORDS * BITS_PER_WORD,
+                               nullptr, 0) != 0) {
+                    return;
+                }
+                bound = syscall(SYS_set_mempolicy, MPOL_BIND, node_mask, NODE_MASK_WORDS * BITS_PER_WORD) == 0;
+                if (!bound) {
+                    std::cerr << "WARNING: cannot bind allocations to NUMA node " << node << ": "
+                            << std::strerror(errno) << std::endl;
+                }
+            }
+
+            ~ThreadNodeBinding() {
+                if (bound) {
+                    syscall(SYS_set_mempolicy, previous_mode,
+                            previous_mode == MPOL_DEFAULT ? nullptr : previous_mask, NODE_MASK_WORDS * BITS_PER_WORD);
+                }
+            }
+
+            ThreadNodeBinding(const ThreadNodeBinding &) = delete;
+
+            ThreadNodeBinding &operator=(const ThreadNodeBinding &) = delete;
+        };
+#endif
+
+    public:
+        [[nodiscard]] static size_t page_size() {
+#if defined(__linux__)
+            return static_cast<size_t>(sysconf(_SC_PAGESIZE));
+#else
+            return 4096;
+#endif
+        }
+
+        [[nodiscard]] static size_t round_up_to_page(const size_t size) {
+            const size_t page = page_size();
+            return (size + page - 1) / page * page;
+        }
+
+        // restrict the pages of [address, address + size) to "node", returns false (with a warning) if the kernel refuses
+        static bool bind_to_node(void *address, const size_t size, const int node) {
+#if defined(__linux__)
+            unsigned long node_mask[NODE_MASK_WORDS] = {};
+            if (!make_node_mask(node, node_mask)) {
+                return false;
+            }
+
+            if (syscall(SYS_mbind, address, size, MPOL_BIND, node_mask, NODE_MASK_WORDS * BITS_PER_WORD,
+                        MPOL_MF_STRICT | MPOL_MF_MOVE) != 0) {
+                std::cerr << "WARNING: cannot bind memory to NUMA node " << node << ": " << std::strerror(errno)
+                        << std::endl;
+                return false;
+            }
+            return true;
+#else
+            return false;
+#endif
+        }
+
+        // write one byte per page so the kernel allocates them now, on the node of the calling thread
+        static void touch_pages(void *address, const size_t size) {
+            volatile char *bytes = static_cast<char *>(address);
+            const size_t page = page_size();
+            for (size_t offset = 0; offset < size; offset += page) {
+                bytes[offset] = 0;
+            }
+        }
+
+        template<typename T, typename... Args>
+        [[nodiscard]] static NumaUniquePtr<T> make_on_node(const NumaPolicy &policy, Args &&... args) {
+#if defined(__linux__)
+            static_assert(alignof(T) <= 4096, "page aligned memory cannot satisfy this alignment");
+
+            std::vector<int> node_cpus;
+            if (policy.placement == NumaPlacement::FIRST_TOUCH) {
+                node_cpus = CpuTopology::read().get_numa_node_cpus(policy.node);
+                if (node_cpus.empty()) {
+                    throw std::invalid_argument(
+                        "NUMA node " + std::to_string(policy.node) + " has no cpu to touch from");
+                }
+            }
+
+            const size_t size = round_up_to_page(sizeof(T));
+            void *memory = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (memory == MAP_FAILED) {
+                throw std::bad_alloc();
+            }
+
+            T *object = nullptr;
+            try {
+                if (policy.placement == NumaPlacement::BIND) {
+                    bind_to_node(memory, size, policy.node);
+                    // the out-of-line mappings of T are populated by its constructor, under this thread's policy
+                    const ThreadNodeBinding binding(policy.node);
+                    object = new(memory) T(std::forward<Args>(args)...);
+                } else {
+                    std::exception_ptr error;
+                    std::thread constructor = ThreadFactory::create({node_cpus, std::nullopt, "numa-touch"}, [&] {
+                        try {
+                            touch_pages(memory, size);
+                            object = new(memory) T(std::forward<Args>(args)...);
+                        } catch (...) {
+                            error = std::current_exception();
+                        }
+                    });
+                    constructor.join();
+                    if (error) {
+                        std::rethrow_exception(error);
+                    }
+                }
+            } catch (...) {
+                munmap(memory, size);
+                throw;
+            }
+
+            return NumaUniquePtr<T>(object, NumaDeleter<T>(size));
+#else
+            return NumaUniquePtr<T>(new T(std::forward<Args>(args)...), NumaDeleter<T>());
+#endif
+        }
+
+        // node that currently backs "address", -1 if unknown
+        [[nodiscard]] static int get_node_of(const void *address) {
+#if defined(__linux__)
+            int node = -1;
+            if (syscall(SYS_get_mempolicy, &node, nullptr, 0, address, MPOL_F_NODE | MPOL_F_ADDR) != 0) {
+                return -1;
+            }
+            return node;
+#else
+            return -1;
+#endif
+        }
+    };
+}
@@ -0,0 +1,186 @@
+#pragma once
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "../barriers/ProcessingSequenceBarrier.hpp"
+#include "../processor/BatchEventProcessor.hpp"
+#include "../ring_buffer/RingBuffer.hpp"
+#include "../sequence/Sequence.hpp"
+#include "../common/Util.hpp"
+#include "../common/BackoffPolicy.hpp"
+#include "../thread/ThreadFactory.hpp"
+
+/**
+ * K independent rings behind a key router, to scale past the cursor of a single sequencer.
+ * Each partition owns its ring, its sequencer (SequencerType: SingleProducerSequencer or MultiProducerSequencer) and a
+ * chain of BatchEventProcessors: stage 0 listens to the sequencer, stage j to stage j - 1, the sequencer gates on the
+ * last stage. Events of one key always go to the same partition, so they stay in order; there is no order between
+ * partitions.
+ * With SingleProducerSequencer, a partition must only be published to from one thread (give each producer thread its
+ * own keys).
+ */
+namespace disruptor {
+    struct PartitionStats {
+        size_t published = 0; // claimed sequences (a claimed sequence of a MultiProducerSequencer may not be published yet)
+        size_t processed = 0; // handled by the last stage
+        size_t remaining_capacity = 0; // free slots before the producers block
+    };
+
+
+    template<typename T, size_t BUFFER_SIZE, template<typename, size_t, size_t> class SequencerType, WaitStrategyType W>
+    class PartitionedDisruptor final {
+    public:
+        using EventHandler = std::function<void(T &, size_t, bool)>;
+        // handlers of one partition's chain, in stage order
+        using StageFactory = std::function<std::vector<EventHandler>(size_t partition)>;
+
+    private:
+        // every type of the chain is known, no vtable between processor, barrier and sequencer
+        using PartitionSequencer = SequencerType<T, BUFFER_SIZE, 1>;
+        using Barrier = ProcessingSequenceBarrier<W, 1, PartitionSequencer>;
+        using Processor = BatchEventProcessor<T, BUFFER_SIZE, EventHandler, Barrier>;
+
+        struct Partition {
+            RingBuffer<T, BUFFER_SIZE> ring_buffer;
+            PartitionSequencer sequencer;
+            std::vector<std::unique_ptr<Barrier> > barriers;
+            std::vector<std::unique_ptr<Processor> > processors;
+
+            explicit Partition(std::function<T()> event_factory)
+                : ring_buffer(std::move(event_factory)),
+                  sequencer(ring_buffer) {
+            }
+        };
+
+        std::vector<std::unique_ptr<Partition> > partitions;
+        const size_t initial_sequence = Util::calculate_initial_value_sequence(BUFFER_SIZE);
+
+    public:
+        PartitionedDisruptor(const size_t number_of_partitions,
+                             const std::function<T()> &event_factory,
+                             const StageFactory &stage_factory,
+                             const BackoffPolicy &backoff_policy = BackoffPolicy{}) {
+            if (number_of_partitions == 0) {
+                throw_or_abort(std::invalid_argument("PartitionedDisruptor needs at least one partition"));
+            }
+
+            for (size_t p = 0; p < number_of_partitions; ++p) {
+                auto partition = std::make_unique<Partition>(event_factory);
+                const std::vector<EventHandler> stages = stage_factory(p);
+                if (stages.empty()) {
+                    throw_or_abort(std::invalid_argument("partition " + std::to_string(p) + " has no handler"));
+                }
+
+                for (size_t stage = 0; stage < stages.size(); ++stage) {
+                    Sequence &upstream = stage == 0
+                                             ? partition->sequencer.get_cursor()
+                                             : partition->processors.back()->get_cursor();
+                    partition->barriers.push_back(std::make_unique<Barrier>(
+                        stage == 0, std::initializer_list<std::reference_wrapper<Sequence> >{upstream},
+                        partition->sequencer, backoff_policy));
+                    partition->processors.push_back(std::make_unique<Processor>(
+                        *partition->barriers.back(), stages[stage], partition->ring_buffer));
+                }
+                partition->sequencer.add_gating_sequences({partition->processors.back()->get_cursor()});
+
+                partitions.push_back(std::move(partition));
+            }
+        }
+
+        PartitionedDisruptor(const PartitionedDisruptor &) = delete;
+
+        PartitionedDisruptor &operator=(const PartitionedDisruptor &) = delete;
+
+        [[nodiscard]] size_t size() const {
+            return partitions.size();
+        }
+
+        [[nodiscard]] size_t get_partition_of(const size_t key) const {
+            return key % partitions.size();
+        }
+
+        /**
+         * Claim a slot on the partition of "key", fill it with fill(event, sequence) and publish it.
+         * Blocks while that partition is full, the other partitions are not affected.
+         * @return the published sequence, in the sequence space of the partition
+         */
+        template<typename Fill>
+        size_t publish(const size_t key, Fill &&fill) {
+            Partition &partition = *partitions[get_partition_of(key)];
+            const size_t sequence = partition.sequencer.next(1);
+            fill(partition.ring_buffer.get(sequence), sequence);
+            partition.sequencer.publish(sequence);
+            return sequence;
+        }
+
+        /**
+         * Free slots of the partition, producers can check it to shed or delay the load of a hot partition.
+         * Safe from any thread: the consumers are read without touching the producer's cached minimum, and the cursor
+         * is read first so the consumers read afterwards can only be further along (a smaller, never negative, gap).
+         */
+        [[nodiscard]] size_t get_remaining_capacity(const size_t partition) {
+            Partition &target = *partitions.at(partition);
+            const size_t claimed = target.sequencer.get_cursor().get_with_acquire();
+            const size_t consumed = target.sequencer.read_minimum_gating_sequence();
+            const size_t in_use = claimed > consumed ? claimed - consumed : 0;
+            return in_use < BUFFER_SIZE ? BUFFER_SIZE - in_use : 0;
+        }
+
+        [[nodiscard]] PartitionStats get_stats(const size_t partition) {
+            Partition &target = *partitions.at(partition);
+            PartitionStats stats;
+            stats.published = target.sequencer.get_cursor().get_with_acquire() - initial_sequence;
+            stats.processed = target.processors.back()->get_cursor().get_with_acquire() - initial_sequence;
+            stats.remaining_capacity = get_remaining_capacity(partition);
+            return stats;
+        }
+
+        // sum over the partitions
+        [[nodiscard]] PartitionStats get_aggregate_stats() {
+            PartitionStats total;
+            for (size_t p = 0; p < partitions.size(); ++p) {
+                const PartitionStats stats = get_stats(p);
+                total.published += stats.published;
+                total.processed += stats.processed;
+                total.remaining_capacity += stats.remaining_capacity;
+            }
+            return total;
+        }
+
+        [[nodiscard]] PartitionSequencer &get_sequencer(const size_t partition) {
+            return partitions.at(partition)->sequencer;
+        }
+
+        [[nodiscard]] RingBuffer<T, BUFFER_SIZE> &get_ring_buffer(const size_t partition) {
+            return partitions.at(partition)->ring_buffer;
+        }
+
+        [[nodiscard]] Processor &get_processor(const size_t partition, const size_t stage) {
+            return *partitions.at(partition)->processors.at(stage);
+        }
+
+        // one thread per processor, partition by partition and stage by stage; configs[i] is applied to the i-th
+        // thread in that order (missing entries start unpinned)
+        [[nodiscard]] std::vector<std::thread> start(const std::vector<ThreadConfig> &configs = {}) {
+            std::vector<std::thread> threads;
+            for (const auto &partition: partitions) {
+                for (const auto &processor: partition->processors) {
+                    const size_t i = threads.size();
+                    threads.push_back(processor->start(i < configs.size() ? configs[i] : ThreadConfig{}));
+                }
+            }
+            return threads;
+        }
+
+        void halt() const {
+            for (const auto &partition: partitions) {
+                for (const auto &processor: partition->processors) {
+                    processor->halt();
+                }
+            }
+        }
+    };
+}
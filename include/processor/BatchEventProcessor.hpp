@@ -1,29 +1,102 @@
 #pragma once
+#include <algorithm>
+#include <concepts>
 #include <functional>
 #include <iostream>
+#include <span>
+#include <stdexcept>
+#include <stop_token>
 
 #include "../sequence/Sequence.hpp"
+#include "../sequence/GatingTree.hpp"
 #include "../barriers/SequenceBarrier.hpp"
 #include "../ring_buffer/RingBuffer.hpp"
 #include "../common/Util.hpp"
+#include "../thread/ThreadFactory.hpp"
 
 namespace disruptor {
-    template<typename T, size_t BUFFER_SIZE>
+    // called with the event, its sequence and the end of batch flag
+    template<typename Handler, typename T>
+    concept EventHandlerFor = std::invocable<Handler &, T &, size_t, bool>;
+
+    // on_batch(first, second, first_sequence) is called once per batch with the events of RingBuffer::get_range
+    template<typename Handler, typename T>
+    concept SpanHandlerFor = requires(Handler &handler, std::span<T> span, size_t sequence) {
+        handler.on_batch(span, span, sequence);
+    };
+
+
+    /**
+     * Handed to a handler with a set_sequence_callback member before the first batch (like Java's
+     * SequenceReportingEventHandler): set(sequence) releases the slots up to "sequence" to the producer in the middle
+     * of a batch, instead of at its end.
+     */
+    class SequenceCallback final {
+        // pointers, so a handler can keep a copy and replace it
+        Sequence *sequence;
+        GatingNode *gating_node;
+
+    public:
+        SequenceCallback(Sequence &sequence, GatingNode *gating_node) : sequence(&sequence), gating_node(gating_node) {
+        }
+
+        // "processed_sequence" and every sequence before it are handled
+        void set(const size_t processed_sequence) const {
+            sequence->set_with_release(processed_sequence);
+            if (gating_node != nullptr) {
+                gating_node->refresh();
+            }
+        }
+    };
+
+    template<typename Handler>
+    concept SequenceReportingHandler = requires(Handler &handler, SequenceCallback callback) {
+        handler.set_sequence_callback(callback);
+    };
+
+
+    /**
+     * EventHandler defaults to std::function for convenience. Pass the type of a lambda or functor instead
+     * (BatchEventProcessor<T, BUFFER_SIZE, decltype(handler)>) to let the compiler inline the handler in the batch loop.
+     * Barrier defaults to the SequenceBarrier interface. With the concrete barrier type, e.g.
+     * ProcessingSequenceBarrier<W, N, SingleProducerSequencer<T, BUFFER_SIZE, G> >, the whole pipeline (processor,
+     * barrier, wait strategy, sequencer) is resolved at compile time; the deduction guide below picks both types from
+     * the constructor arguments.
+     * A handler type with an on_batch member (SpanHandlerFor) gets the whole available range in one call instead of one
+     * call per event: first holds the events from first_sequence up to the end of the buffer, second the rest of the
+     * batch from the start of the buffer (empty unless the batch wraps), so the handler can loop over plain arrays.
+     * Either kind of handler can also be a SequenceReportingHandler.
+     */
+    template<typename T, size_t BUFFER_SIZE, typename EventHandler = std::function<void(T &, size_t, bool)>,
+        typename Barrier = SequenceBarrier>
+        requires (EventHandlerFor<EventHandler, T> || SpanHandlerFor<EventHandler, T>)
+                 && std::derived_from<Barrier, SequenceBarrier>
     class BatchEventProcessor final {
         Sequence sequence;
-        SequenceBarrier &sequence_barrier;
+        Barrier &sequence_barrier;
 
-        using EventHandler = std::function<void(T &, size_t, bool)>;
         EventHandler event_handler;
 
+        // called with the last processed sequence when no event arrives within "timeout"
+        using TimeoutHandler = std::function<void(size_t)>;
+        TimeoutHandler timeout_handler;
+        std::chrono::nanoseconds timeout{0};
+
         RingBuffer<T, BUFFER_SIZE> &ring_buffer;
 
+        // refreshed after every batch when the producer gates on a GatingTree
+        GatingNode *gating_node = nullptr;
+
+        // the sequence is released at least every max_batch_size events
+        size_t max_batch_size;
+
     public:
-        explicit BatchEventProcessor(SequenceBarrier &barrier, EventHandler handler, RingBuffer<T, BUFFER_SIZE> &ring_buffer_ptr
+        explicit BatchEventProcessor(Barrier &barrier, EventHandler handler, RingBuffer<T, BUFFER_SIZE> &ring_buffer_ptr
         ) : sequence(Util::calculate_initial_value_sequence(ring_buffer_ptr.get_buffer_size())),
             sequence_barrier(barrier),
-            event_handler(handler),
-            ring_buffer(ring_buffer_ptr) {
+            event_handler(std::move(handler)),
+            ring_buffer(ring_buffer_ptr),
+            max_batch_size(ring_buffer_ptr.get_buffer_size()) {
         }
 
 
@@ -32,6 +105,44 @@ namespace disruptor {
         }
 
 
+        // the processor's own copy of the handler, to read the state of a functor once the processor is halted
+        [[nodiscard]] EventHandler &get_event_handler() {
+            return event_handler;
+        }
+
+
+        /**
+         * Flush partial batches when traffic stops: "handler" is called on the processor thread whenever no event
+         * arrives within "duration". Must be set before run().
+         */
+        void set_timeout_handler(TimeoutHandler handler, const std::chrono::nanoseconds duration) {
+            timeout_handler = std::move(handler);
+            timeout = duration;
+        }
+
+
+        /**
+         * Split the available events into batches of at most "batch_size": the producer gets the slots back and the
+         * handler sees end_of_batch after each of them, instead of once after everything that was available.
+         * Bounds how long a consumer that falls behind on a large ring holds the producer. Must be set before run().
+         */
+        void set_max_batch_size(const size_t batch_size) {
+            if (batch_size == 0) {
+                throw_or_abort(std::invalid_argument("max batch size must be greater than 0"));
+            }
+            max_batch_size = batch_size;
+        }
+
+
+        /**
+         * Keep "node" (this processor's parent in a GatingTree) up to date with this processor's progress.
+         * Must be set before run().
+         */
+        void set_gating_node(GatingNode &node) {
+            gating_node = &node;
+        }
+
+
         // stop processor --> sequence barrier --> wait strategy
         void halt() const {
             sequence_barrier.alert();
@@ -42,34 +153,101 @@ namespace disruptor {
             sequence_barrier.clear_alert();
             process_events();
         }
-        
 
+
+        // run() until a stop is requested on "stop_token", e.g. by the std::jthread running it
+        void run(const std::stop_token &stop_token) {
+            sequence_barrier.clear_alert();
+            // registered after clear_alert, a stop requested before run() still halts the processor
+            const std::stop_callback halt_on_stop(stop_token, [this] { halt(); });
+            process_events();
+        }
+
+
+        // run() on a new thread pinned/named/prioritised according to "config"
+        [[nodiscard]] std::thread start(const ThreadConfig &config) {
+            return ThreadFactory::create(config, [this] { run(); });
+        }
+
+
+        // same as start, the processor halts when the returned std::jthread is stopped or destroyed
+        [[nodiscard]] std::jthread start_jthread(const ThreadConfig &config) {
+            return ThreadFactory::create_jthread(config, [this](const std::stop_token &stop_token) {
+                run(stop_token);
+            });
+        }
+
+
+        /**
+         * Alerts and timeouts come back as a WaitStatus, no exception is thrown on the way out. Without exceptions
+         * (-fno-exceptions) there is no try block at all; otherwise an exception thrown by the handler stops the
+         * processor.
+         */
         void process_events() {
             size_t next_sequence = sequence.get() + 1;
+            // what the barrier returned last, the batches are cut from it without waiting again
+            size_t available_sequence = sequence.get();
             int wait_counter = 0;
 
-            while (true) {
-                try {
-                    const size_t available_sequence = sequence_barrier.wait_for(next_sequence);
+            if constexpr (SequenceReportingHandler<EventHandler>) {
+                event_handler.set_sequence_callback(SequenceCallback(sequence, gating_node));
+            }
 
-                    // if multi_producer_sequencer, sequence was claimed but not publish --> available_sequence = next_sequence - 1
+#if defined(__cpp_exceptions)
+            try {
+#endif
+                while (true) {
                     if (available_sequence < next_sequence) {
-                        Util::adaptive_wait(wait_counter);
-                        continue;
+                        const WaitResult result = sequence_barrier.try_wait_for(
+                            next_sequence, timeout_handler ? std::chrono::steady_clock::now() + timeout : NO_DEADLINE);
+
+                        if (result.status != WaitStatus::AVAILABLE) [[unlikely]] {
+                            if (result.status == WaitStatus::ALERTED) {
+                                break;
+                            }
+                            timeout_handler(sequence.get());
+                            continue;
+                        }
+                        available_sequence = result.available_sequence;
+
+                        // if multi_producer_sequencer, sequence was claimed but not publish
+                        // --> available_sequence = next_sequence - 1
+                        if (available_sequence < next_sequence) {
+                            Util::adaptive_wait(wait_counter);
+                            continue;
+                        }
                     }
-
-                    while (next_sequence <= available_sequence) {
-                        T &event = ring_buffer.get(next_sequence);
-                        event_handler(event, next_sequence, next_sequence == available_sequence);
-                        next_sequence++;
+                    const size_t end_of_batch_sequence = std::min(available_sequence,
+                                                                  next_sequence + max_batch_size - 1);
+
+                    if constexpr (SpanHandlerFor<EventHandler, T>) {
+                        const auto [first, second] = ring_buffer.get_range(next_sequence, end_of_batch_sequence);
+                        event_handler.on_batch(first, second, next_sequence);
+                        next_sequence = end_of_batch_sequence + 1;
+                    } else {
+                        while (next_sequence <= end_of_batch_sequence) {
+                            T &event = ring_buffer.get(next_sequence);
+                            event_handler(event, next_sequence, next_sequence == end_of_batch_sequence);
+                            next_sequence++;
+                        }
                     }
 
-                    sequence.set_with_release(available_sequence);
-                } catch (const std::exception &e) {
-                    std::cout << "BatchEventProcessor exception caught: " << e.what() << std::endl;
-                    break;
+                    sequence.set_with_release(end_of_batch_sequence);
+                    if (gating_node != nullptr) {
+                        gating_node->refresh();
+                    }
                 }
+#if defined(__cpp_exceptions)
+            } catch (const std::exception &e) {
+                std::cout << "BatchEventProcessor exception caught: " << e.what() << std::endl;
             }
+#endif
         }
     };
+
+
+    // BatchEventProcessor processor(barrier, handler, ring_buffer): handler and barrier keep their own types
+    template<typename Barrier, typename EventHandler, typename T, size_t BUFFER_SIZE>
+    BatchEventProcessor(Barrier &, EventHandler, RingBuffer<T, BUFFER_SIZE> &)
+        -> BatchEventProcessor<T, BUFFER_SIZE, EventHandler, Barrier>;
 }
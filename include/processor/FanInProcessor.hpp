@@ -0,0 +1,268 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include "../sequence/Sequence.hpp"
+#include "../sequencer/Sequencer.hpp"
+#include "../ring_buffer/RingBuffer.hpp"
+#include "../common/Util.hpp"
+#include "../common/BackoffPolicy.hpp"
+#include "../thread/ThreadFactory.hpp"
+
+/**
+ * One consumer thread draining M rings, typically one SingleProducerSequencer ring per producer thread: every producer
+ * keeps the uncontended single producer path instead of sharing the cursor of a MultiProducerSequencer.
+ * Each poll round takes a snapshot of the published events of every source (at most "max_batch_size" per source) and
+ * hands them to the handler:
+ * - round robin (default): source by source, in sequence order within a source. A source is released as soon as its
+ *   part of the round is handled.
+ * - timestamp merge (set_timestamp_merge): the timestamps of each producer must only go up. An event is only handed out
+ *   once every other source has shown an event at least as recent (watermark): a source with events waiting bounds
+ *   the merge by the timestamp of its oldest one, an empty source by the timestamp of the last event it published.
+ *   Events held back stay in their ring and are merged in a later round, so the output is in time order across rounds.
+ *   A source that published nothing for "idle_timeout" stops holding the others back, an event it publishes later
+ *   than that may be handed out after more recent ones.
+ * The end of batch flag is set on the last event handed out in the round.
+ * The processor owns the sequence it releases on each source: gate each sequencer on get_cursor(source).
+ */
+namespace disruptor {
+    template<typename T, size_t BUFFER_SIZE>
+    class FanInProcessor final {
+        struct Source {
+            alignas(CACHE_LINE_SIZE) Sequence sequence;
+            RingBuffer<T, BUFFER_SIZE> &ring_buffer;
+            Sequencer &sequencer;
+            const Sequence &cursor;
+            size_t next_sequence = 0;
+            size_t available_sequence = 0;
+
+            // timestamp merge only
+            uint64_t head_timestamp = 0; // timestamp of next_sequence
+            uint64_t last_timestamp = 0; // timestamp of the last event handed out
+            bool reported = false; // at least one event handed out, last_timestamp is valid
+            std::chrono::steady_clock::time_point last_active = std::chrono::steady_clock::now();
+
+            Source(RingBuffer<T, BUFFER_SIZE> &ring_buffer, Sequencer &sequencer, const Sequence &cursor)
+                : sequence(Util::calculate_initial_value_sequence(ring_buffer.get_buffer_size())),
+                  ring_buffer(ring_buffer),
+                  sequencer(sequencer),
+                  cursor(cursor) {
+            }
+        };
+
+        // called with the source index, the sequence in that source and the end of round flag
+        using EventHandler = std::function<void(T &, size_t, size_t, bool)>;
+        EventHandler event_handler;
+
+        using TimestampFunction = std::function<uint64_t(const T &)>;
+        TimestampFunction timestamp_function;
+        std::chrono::nanoseconds idle_timeout{0};
+
+        std::vector<std::unique_ptr<Source> > sources;
+        const size_t max_batch_size;
+        const BackoffPolicy backoff_policy;
+
+        alignas(CACHE_LINE_SIZE) std::atomic<bool> alerted{false};
+
+        // snapshot the published events of every source, @return the number of events in the round
+        [[gnu::hot]] size_t snapshot() {
+            size_t total = 0;
+            for (const auto &source: sources) {
+                const size_t next_sequence = source->sequence.get() + 1;
+                const size_t published = source->sequencer.get_highest_published_sequence(
+                    next_sequence, source->cursor.get_with_acquire());
+                source->next_sequence = next_sequence;
+                source->available_sequence = published < next_sequence
+                                                 ? next_sequence - 1
+                                                 : std::min(published, next_sequence + max_batch_size - 1);
+                total += source->available_sequence + 1 - next_sequence;
+            }
+            return total;
+        }
+
+        void handle_round_robin(size_t remaining) {
+            for (size_t index = 0; index < sources.size(); ++index) {
+                Source &source = *sources[index];
+                if (source.available_sequence < source.next_sequence) {
+                    continue;
+                }
+                for (size_t next_sequence = source.next_sequence; next_sequence <= source.available_sequence;
+                     ++next_sequence) {
+                    event_handler(source.ring_buffer.get(next_sequence), index, next_sequence, --remaining == 0);
+                }
+                source.sequence.set_with_release(source.available_sequence);
+            }
+        }
+
+        // the source with the oldest waiting event if the watermark lets it go, sources.size() otherwise
+        [[nodiscard]] size_t pick_oldest(const std::chrono::steady_clock::time_point now) const {
+            // ties go to the lowest source index
+            size_t oldest = sources.size();
+            for (size_t index = 0; index < sources.size(); ++index) {
+                const Source &source = *sources[index];
+                if (source.next_sequence <= source.available_sequence
+                    && (oldest == sources.size() || source.head_timestamp < sources[oldest]->head_timestamp)) {
+                    oldest = index;
+                }
+            }
+            if (oldest == sources.size()) {
+                return oldest;
+            }
+
+            // an empty source may still publish anything from its last timestamp on
+            const uint64_t timestamp = sources[oldest]->head_timestamp;
+            for (const auto &source: sources) {
+                const bool empty = source->next_sequence > source->available_sequence;
+                if (empty && now - source->last_active < idle_timeout
+                    && (!source->reported || source->last_timestamp < timestamp)) {
+                    return sources.size();
+                }
+            }
+            return oldest;
+        }
+
+        // @return the number of events handed out, the others are left for a later round
+        size_t handle_timestamp_merge() {
+            const auto now = std::chrono::steady_clock::now();
+            for (const auto &source: sources) {
+                if (source->next_sequence <= source->available_sequence) {
+                    source->head_timestamp = timestamp_function(source->ring_buffer.get(source->next_sequence));
+                    source->last_active = now;
+                }
+            }
+
+            size_t handled = 0;
+            size_t current = pick_oldest(now);
+            while (current != sources.size()) {
+                Source &source = *sources[current];
+                const size_t sequence = source.next_sequence;
+                source.last_timestamp = source.head_timestamp;
+                source.reported = true;
+                if (++source.next_sequence <= source.available_sequence) {
+                    source.head_timestamp = timestamp_function(source.ring_buffer.get(source.next_sequence));
+                }
+
+                // look ahead to set the end of round flag on the last event the watermark lets go
+                const size_t next = pick_oldest(now);
+                event_handler(source.ring_buffer.get(sequence), current, sequence, next == sources.size());
+                ++handled;
+                current = next;
+            }
+
+            for (const auto &source: sources) {
+                if (source->next_sequence - 1 > source->sequence.get()) {
+                    source->sequence.set_with_release(source->next_sequence - 1);
+                }
+            }
+            return handled;
+        }
+
+    public:
+        explicit FanInProcessor(EventHandler handler, const size_t max_batch_size = BUFFER_SIZE,
+                                const BackoffPolicy &backoff_policy = BackoffPolicy{})
+            : event_handler(std::move(handler)),
+              max_batch_size(max_batch_size),
+              backoff_policy(backoff_policy) {
+            if (max_batch_size == 0) {
+                throw_or_abort(std::invalid_argument("max_batch_size must be > 0"));
+            }
+        }
+
+        FanInProcessor(const FanInProcessor &) = delete;
+
+        FanInProcessor &operator=(const FanInProcessor &) = delete;
+
+
+        /**
+         * Drain "ring_buffer", published through "sequencer" whose cursor is "cursor". Must be called before run().
+         * @return the index of the source, passed to the handler
+         */
+        size_t add_source(RingBuffer<T, BUFFER_SIZE> &ring_buffer, Sequencer &sequencer, const Sequence &cursor) {
+            sources.push_back(std::make_unique<Source>(ring_buffer, sequencer, cursor));
+            return sources.size() - 1;
+        }
+
+
+        /**
+         * Merge the sources by "timestamp" instead of round robin. Must be set before run().
+         * @param idle_timeout how long an empty source holds the merge back before it is considered idle
+         */
+        void set_timestamp_merge(TimestampFunction timestamp,
+                                 const std::chrono::nanoseconds idle_timeout = std::chrono::milliseconds(1)) {
+            timestamp_function = std::move(timestamp);
+            this->idle_timeout = idle_timeout;
+        }
+
+
+        // the sequence the sequencer of "source" has to gate on
+        [[nodiscard]] Sequence &get_cursor(const size_t source) {
+            return sources.at(source)->sequence;
+        }
+
+
+        [[nodiscard]] size_t size() const {
+            return sources.size();
+        }
+
+
+        void halt() {
+            alerted.store(true, std::memory_order_release);
+        }
+
+
+        void run() {
+            alerted.store(false, std::memory_order_release);
+            // a source that has not published yet holds the merge back for idle_timeout from now
+            const auto now = std::chrono::steady_clock::now();
+            for (const auto &source: sources) {
+                source->last_active = now;
+            }
+            process_events();
+        }
+
+
+        // run() on a new thread pinned/named/prioritised according to "config"
+        [[nodiscard]] std::thread start(const ThreadConfig &config) {
+            return ThreadFactory::create(config, [this] { run(); });
+        }
+
+
+        void process_events() {
+            if (sources.empty()) {
+                throw_or_abort(std::invalid_argument("FanInProcessor needs at least one source"));
+            }
+
+            int wait_counter = 0;
+#if defined(__cpp_exceptions)
+            try {
+#endif
+                while (!alerted.load(std::memory_order_acquire)) {
+                    size_t handled = snapshot();
+                    if (handled > 0) {
+                        if (timestamp_function) {
+                            handled = handle_timestamp_merge();
+                        } else {
+                            handle_round_robin(handled);
+                        }
+                    }
+                    if (handled == 0) {
+                        Util::adaptive_wait(wait_counter, backoff_policy);
+                        continue;
+                    }
+                    wait_counter = 0;
+                }
+#if defined(__cpp_exceptions)
+            } catch (const std::exception &e) {
+                std::cout << "FanInProcessor exception caught: " << e.what() << std::endl;
+            }
+#endif
+        }
+    };
+}
@@ -0,0 +1,151 @@
+#pragma once
+#include <functional>
+#include <iostream>
+#include <stdexcept>
+#include <type_traits>
+
+#include "../sequence/Sequence.hpp"
+#include "../sequence/GatingTree.hpp"
+#include "../barriers/SequenceBarrier.hpp"
+#include "../ring_buffer/RingBuffer.hpp"
+#include "../common/Util.hpp"
+#include "../thread/ThreadFactory.hpp"
+
+/**
+ * Broadcast processor that only handles its own shard of the events: the ones where
+ * shard_function(event) % shard_count == shard_index. Every shard sees every sequence, so events of one key are
+ * handled in order by one thread, without any counter shared between the shards.
+ * The shard function is a template parameter and is inlined in the batch loop: an event of another shard costs the
+ * shard computation only, the handler is called for the events of this shard and the sequence is released once per
+ * batch whatever the number of skipped events.
+ */
+namespace disruptor {
+    template<typename T, size_t BUFFER_SIZE, typename ShardFunction>
+        requires std::is_invocable_r_v<size_t, ShardFunction &, const T &>
+    class ShardedEventProcessor final {
+        Sequence sequence;
+        SequenceBarrier &sequence_barrier;
+
+        using EventHandler = std::function<void(T &, size_t, bool)>;
+        EventHandler event_handler;
+
+        ShardFunction shard_function;
+        const size_t shard_index;
+        const size_t shard_count;
+
+        RingBuffer<T, BUFFER_SIZE> &ring_buffer;
+
+        // refreshed after every batch when the producer gates on a GatingTree
+        GatingNode *gating_node = nullptr;
+
+        /**
+         * Call the handler for the events of this shard in [first, last]. The end of batch flag goes to the last event
+         * of this shard in the range, so the handler can still flush once per batch.
+         */
+        [[gnu::hot]] void handle_shard(const size_t first, const size_t last) {
+            bool has_pending = false;
+            size_t pending = 0;
+            for (size_t next_sequence = first; next_sequence <= last; ++next_sequence) {
+                if (shard_function(ring_buffer.get(next_sequence)) % shard_count != shard_index) {
+                    continue;
+                }
+                if (has_pending) {
+                    event_handler(ring_buffer.get(pending), pending, false);
+                }
+                pending = next_sequence;
+                has_pending = true;
+            }
+            if (has_pending) {
+                event_handler(ring_buffer.get(pending), pending, true);
+            }
+        }
+
+    public:
+        ShardedEventProcessor(SequenceBarrier &barrier, EventHandler handler, RingBuffer<T, BUFFER_SIZE> &ring_buffer,
+                              ShardFunction shard_function, const size_t shard_index, const size_t shard_count)
+            : sequence(Util::calculate_initial_value_sequence(ring_buffer.get_buffer_size())),
+              sequence_barrier(barrier),
+              event_handler(std::move(handler)),
+              shard_function(std::move(shard_function)),
+              shard_index(shard_index),
+              shard_count(shard_count),
+              ring_buffer(ring_buffer) {
+            if (shard_index >= shard_count) {
+                throw_or_abort(std::invalid_argument("shard_index must be < shard_count"));
+            }
+        }
+
+
+        [[nodiscard]] Sequence &get_cursor() {
+            return sequence;
+        }
+
+
+        [[nodiscard]] size_t get_shard_index() const {
+            return shard_index;
+        }
+
+
+        /**
+         * Keep "node" (this processor's parent in a GatingTree) up to date with this processor's progress.
+         * Must be set before run().
+         */
+        void set_gating_node(GatingNode &node) {
+            gating_node = &node;
+        }
+
+
+        // stop processor --> sequence barrier --> wait strategy
+        void halt() const {
+            sequence_barrier.alert();
+        }
+
+
+        void run() {
+            sequence_barrier.clear_alert();
+            process_events();
+        }
+
+
+        // run() on a new thread pinned/named/prioritised according to "config"
+        [[nodiscard]] std::thread start(const ThreadConfig &config) {
+            return ThreadFactory::create(config, [this] { run(); });
+        }
+
+
+        void process_events() {
+            size_t next_sequence = sequence.get() + 1;
+            int wait_counter = 0;
+
+#if defined(__cpp_exceptions)
+            try {
+#endif
+                while (true) {
+                    const WaitResult result = sequence_barrier.try_wait_for(next_sequence, NO_DEADLINE);
+                    if (result.status != WaitStatus::AVAILABLE) [[unlikely]] {
+                        break;
+                    }
+                    const size_t available_sequence = result.available_sequence;
+
+                    // if multi_producer_sequencer, sequence was claimed but not publish --> available_sequence = next_sequence - 1
+                    if (available_sequence < next_sequence) {
+                        Util::adaptive_wait(wait_counter);
+                        continue;
+                    }
+
+                    handle_shard(next_sequence, available_sequence);
+                    next_sequence = available_sequence + 1;
+
+                    sequence.set_with_release(available_sequence);
+                    if (gating_node != nullptr) {
+                        gating_node->refresh();
+                    }
+                }
+#if defined(__cpp_exceptions)
+            } catch (const std::exception &e) {
+                std::cout << "ShardedEventProcessor exception caught: " << e.what() << std::endl;
+            }
+#endif
+        }
+    };
+}
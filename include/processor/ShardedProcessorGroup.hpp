@@ -0,0 +1,95 @@
+#pragma once
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "ShardedEventProcessor.hpp"
+#include "../barriers/ProcessingSequenceBarrier.hpp"
+#include "../sequence/GatingTree.hpp"
+#include "../sequencer/Sequencer.hpp"
+#include "../common/BackoffPolicy.hpp"
+
+/**
+ * One ShardedEventProcessor per handler, all on the same dependencies: handlers[i] gets the events where
+ * shard_function(event) % handlers.size() == i, in sequence order.
+ * Each processor gets its own ProcessingSequenceBarrier (a barrier is single thread).
+ * The producer gates on get_gating_sequence() only, the minimum of the shards kept up to date by the shards.
+ */
+namespace disruptor {
+    template<typename T, size_t BUFFER_SIZE, WaitStrategyType W, size_t NUMBER_DEPENDENT_SEQUENCES,
+        typename ShardFunction>
+    class ShardedProcessorGroup final {
+        using Barrier = ProcessingSequenceBarrier<W, NUMBER_DEPENDENT_SEQUENCES>;
+        using Processor = ShardedEventProcessor<T, BUFFER_SIZE, ShardFunction>;
+
+        std::vector<std::unique_ptr<Barrier> > barriers;
+        std::vector<std::unique_ptr<Processor> > processors;
+        std::unique_ptr<GatingTree> gating_tree;
+
+    public:
+        /**
+         * @param direct_publisher_event_listener, dependent_sequences: same as ProcessingSequenceBarrier
+         * @param handlers one per shard
+         */
+        ShardedProcessorGroup(RingBuffer<T, BUFFER_SIZE> &ring_buffer,
+                              Sequencer &sequencer,
+                              const bool direct_publisher_event_listener,
+                              const std::initializer_list<std::reference_wrapper<Sequence> > dependent_sequences,
+                              const ShardFunction &shard_function,
+                              const std::vector<std::function<void(T &, size_t, bool)> > &handlers,
+                              const BackoffPolicy &backoff_policy = BackoffPolicy{}) {
+            if (handlers.empty()) {
+                throw_or_abort(std::invalid_argument("ShardedProcessorGroup needs at least one handler"));
+            }
+
+            std::vector<std::reference_wrapper<Sequence> > cursors;
+            for (size_t i = 0; i < handlers.size(); ++i) {
+                barriers.push_back(std::make_unique<Barrier>(
+                    direct_publisher_event_listener, dependent_sequences, sequencer, backoff_policy));
+                processors.push_back(std::make_unique<Processor>(
+                    *barriers.back(), handlers[i], ring_buffer, shard_function, i, handlers.size()));
+                cursors.emplace_back(processors.back()->get_cursor());
+            }
+
+            gating_tree = std::make_unique<GatingTree>(cursors);
+            for (size_t i = 0; i < processors.size(); ++i) {
+                processors[i]->set_gating_node(gating_tree->get_parent_of(i));
+            }
+        }
+
+        ShardedProcessorGroup(const ShardedProcessorGroup &) = delete;
+
+        ShardedProcessorGroup &operator=(const ShardedProcessorGroup &) = delete;
+
+        // the only sequence the producer (or a downstream processor) has to gate on
+        [[nodiscard]] Sequence &get_gating_sequence() {
+            return gating_tree->get_root();
+        }
+
+        [[nodiscard]] Processor &get_processor(const size_t shard_index) {
+            return *processors.at(shard_index);
+        }
+
+        [[nodiscard]] size_t size() const {
+            return processors.size();
+        }
+
+        // one thread per shard, configs[i] is applied to shard i (missing entries start unpinned)
+        [[nodiscard]] std::vector<std::thread> start(const std::vector<ThreadConfig> &configs = {}) {
+            std::vector<std::thread> threads;
+            threads.reserve(processors.size());
+            for (size_t i = 0; i < processors.size(); ++i) {
+                threads.push_back(processors[i]->start(i < configs.size() ? configs[i] : ThreadConfig{}));
+            }
+            return threads;
+        }
+
+        void halt() const {
+            for (const auto &processor: processors) {
+                processor->halt();
+            }
+        }
+    };
+}
@@ -0,0 +1,142 @@
+#pragma once
+#include <functional>
+#include <iostream>
+
+#include "../sequence/Sequence.hpp"
+#include "../sequence/GatingTree.hpp"
+#include "../barriers/SequenceBarrier.hpp"
+#include "../ring_buffer/RingBuffer.hpp"
+#include "../common/Util.hpp"
+#include "../thread/ThreadFactory.hpp"
+
+/**
+ * Consumer of a WorkerPool: the workers of a pool share one ring and each event is handled by exactly one of them.
+ * A worker claims the next event by moving the pool's work sequence forward with a CAS, then waits on its own barrier
+ * until that event is published.
+ * Before each claim the worker sets its own sequence to the last claimed sequence of the pool, which is a safe gate for
+ * the producer: every event up to there is either processed or claimed by a worker that still has a lower sequence.
+ */
+namespace disruptor {
+    template<typename T, size_t BUFFER_SIZE>
+    class WorkProcessor final {
+        Sequence sequence;
+        SequenceBarrier &sequence_barrier;
+
+        using WorkHandler = std::function<void(T &, size_t)>;
+        WorkHandler work_handler;
+
+        RingBuffer<T, BUFFER_SIZE> &ring_buffer;
+
+        // shared by all the workers of the pool
+        Sequence &work_sequence;
+
+        // when the producer gates on a GatingTree: refreshed before the worker waits on its barrier (once per batch),
+        // and every REFRESH_INTERVAL claims so a worker that never runs dry still lets the producer move on
+        static constexpr size_t REFRESH_INTERVAL = 64;
+        GatingNode *gating_node = nullptr;
+        size_t claims_since_refresh = 0;
+
+        void refresh_gating_node() {
+            if (gating_node != nullptr) {
+                gating_node->refresh();
+                claims_since_refresh = 0;
+            }
+        }
+
+        [[gnu::hot]] size_t claim() {
+            size_t next_sequence;
+            do {
+                next_sequence = work_sequence.get_with_acquire() + 1;
+                sequence.set_with_release(next_sequence - 1);
+            } while (!work_sequence.compare_and_set(next_sequence - 1, next_sequence));
+
+            if (gating_node != nullptr && ++claims_since_refresh == REFRESH_INTERVAL) [[unlikely]] {
+                refresh_gating_node();
+            }
+            return next_sequence;
+        }
+
+    public:
+        explicit WorkProcessor(SequenceBarrier &barrier, WorkHandler handler, RingBuffer<T, BUFFER_SIZE> &ring_buffer,
+                               Sequence &work_sequence)
+            : sequence(Util::calculate_initial_value_sequence(ring_buffer.get_buffer_size())),
+              sequence_barrier(barrier),
+              work_handler(std::move(handler)),
+              ring_buffer(ring_buffer),
+              work_sequence(work_sequence) {
+        }
+
+
+        [[nodiscard]] Sequence &get_cursor() {
+            return sequence;
+        }
+
+
+        /**
+         * Keep "node" (this worker's parent in a GatingTree) up to date with this worker's progress.
+         * Must be set before run().
+         */
+        void set_gating_node(GatingNode &node) {
+            gating_node = &node;
+        }
+
+
+        // stop processor --> sequence barrier --> wait strategy
+        void halt() const {
+            sequence_barrier.alert();
+        }
+
+
+        void run() {
+            sequence_barrier.clear_alert();
+            process_events();
+        }
+
+
+        // run() on a new thread pinned/named/prioritised according to "config"
+        [[nodiscard]] std::thread start(const ThreadConfig &config) {
+            return ThreadFactory::create(config, [this] { run(); });
+        }
+
+
+        void process_events() {
+            bool processed = true;
+            size_t next_sequence = 0;
+            size_t cached_available_sequence = 0;
+            int wait_counter = 0;
+
+#if defined(__cpp_exceptions)
+            try {
+#endif
+                while (true) {
+                    if (processed) {
+                        next_sequence = claim();
+                        processed = false;
+                    }
+
+                    if (cached_available_sequence >= next_sequence) {
+                        work_handler(ring_buffer.get(next_sequence), next_sequence);
+                        processed = true;
+                        wait_counter = 0;
+                        continue;
+                    }
+
+                    refresh_gating_node();
+                    const WaitResult result = sequence_barrier.try_wait_for(next_sequence, NO_DEADLINE);
+                    if (result.status != WaitStatus::AVAILABLE) [[unlikely]] {
+                        break;
+                    }
+                    cached_available_sequence = result.available_sequence;
+                    // multi producer: claimed but not yet published
+                    if (cached_available_sequence < next_sequence) {
+                        Util::adaptive_wait(wait_counter);
+                    }
+                }
+#if defined(__cpp_exceptions)
+            } catch (const std::exception &e) {
+                std::cout << "WorkProcessor exception caught: " << e.what() << std::endl;
+            }
+#endif
+        }
+    };
+}
@@ -0,0 +1,95 @@
+#pragma once
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "WorkProcessor.hpp"
+#include "../barriers/ProcessingSequenceBarrier.hpp"
+#include "../sequence/GatingTree.hpp"
+#include "../sequencer/Sequencer.hpp"
+#include "../common/BackoffPolicy.hpp"
+
+/**
+ * N WorkProcessors sharing one ring: every event is handled by exactly one worker, whichever claims it first.
+ * Used to spread a CPU heavy handler over several cores when the events don't need to be handled in order.
+ * Each worker gets its own ProcessingSequenceBarrier (a barrier is single thread) on the same dependencies.
+ * The producer gates on get_gating_sequence() only, the minimum of the workers kept up to date by the workers.
+ */
+namespace disruptor {
+    template<typename T, size_t BUFFER_SIZE, WaitStrategyType W, size_t NUMBER_DEPENDENT_SEQUENCES>
+    class WorkerPool final {
+        using Barrier = ProcessingSequenceBarrier<W, NUMBER_DEPENDENT_SEQUENCES>;
+
+        alignas(CACHE_LINE_SIZE) Sequence work_sequence;
+        std::vector<std::unique_ptr<Barrier> > barriers;
+        std::vector<std::unique_ptr<WorkProcessor<T, BUFFER_SIZE> > > workers;
+        std::unique_ptr<GatingTree> gating_tree;
+
+    public:
+        /**
+         * @param direct_publisher_event_listener, dependent_sequences: same as ProcessingSequenceBarrier
+         * @param number_of_workers threads sharing the events
+         */
+        WorkerPool(RingBuffer<T, BUFFER_SIZE> &ring_buffer,
+                   Sequencer &sequencer,
+                   const bool direct_publisher_event_listener,
+                   const std::initializer_list<std::reference_wrapper<Sequence> > dependent_sequences,
+                   const std::function<void(T &, size_t)> &handler,
+                   const size_t number_of_workers,
+                   const BackoffPolicy &backoff_policy = BackoffPolicy{})
+            : work_sequence(Util::calculate_initial_value_sequence(ring_buffer.get_buffer_size())) {
+            if (number_of_workers == 0) {
+                throw_or_abort(std::invalid_argument("WorkerPool needs at least one worker"));
+            }
+
+            std::vector<std::reference_wrapper<Sequence> > cursors;
+            for (size_t i = 0; i < number_of_workers; ++i) {
+                barriers.push_back(std::make_unique<Barrier>(
+                    direct_publisher_event_listener, dependent_sequences, sequencer, backoff_policy));
+                workers.push_back(std::make_unique<WorkProcessor<T, BUFFER_SIZE> >(
+                    *barriers.back(), handler, ring_buffer, work_sequence));
+                cursors.emplace_back(workers.back()->get_cursor());
+            }
+
+            gating_tree = std::make_unique<GatingTree>(cursors);
+            for (size_t i = 0; i < number_of_workers; ++i) {
+                workers[i]->set_gating_node(gating_tree->get_parent_of(i));
+            }
+        }
+
+        WorkerPool(const WorkerPool &) = delete;
+
+        WorkerPool &operator=(const WorkerPool &) = delete;
+
+        // the only sequence the producer (or a downstream processor) has to gate on
+        [[nodiscard]] Sequence &get_gating_sequence() {
+            return gating_tree->get_root();
+        }
+
+        [[nodiscard]] WorkProcessor<T, BUFFER_SIZE> &get_worker(const size_t index) {
+            return *workers.at(index);
+        }
+
+        [[nodiscard]] size_t size() const {
+            return workers.size();
+        }
+
+        // one thread per worker, configs[i] is applied to worker i (missing entries start unpinned)
+        [[nodiscard]] std::vector<std::thread> start(const std::vector<ThreadConfig> &configs = {}) {
+            std::vector<std::thread> threads;
+            threads.reserve(workers.size());
+            for (size_t i = 0; i < workers.size(); ++i) {
+                threads.push_back(workers[i]->start(i < configs.size() ? configs[i] : ThreadConfig{}));
+            }
+            return threads;
+        }
+
+        void halt() const {
+            for (const auto &worker: workers) {
+                worker->halt();
+            }
+        }
+    };
+}
@@ -2,7 +2,13 @@
 
 #include <functional>
 #include <array>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <utility>
 #include "../common/Common.hpp"
+#include "../common/Util.hpp"
+#include "../memory/HugePageBuffer.hpp"
 
 namespace disruptor {
     template<typename T, size_t BUFFER_SIZE>
@@ -30,8 +36,82 @@ namespace disruptor {
             return entries[sequence & INDEX_MASK];
         }
 
+        /**
+         * The entries of [first_sequence, last_sequence] (at most BUFFER_SIZE of them) as two contiguous spans, split
+         * where the range wraps around the end of the buffer; the second span is empty when it doesn't wrap.
+         */
+        [[gnu::hot]] [[nodiscard]] std::pair<std::span<T>, std::span<T> > get_range(
+            const size_t first_sequence, const size_t last_sequence) noexcept {
+            const size_t first_index = first_sequence & INDEX_MASK;
+            const size_t count = last_sequence - first_sequence + 1;
+            const size_t until_end = BUFFER_SIZE - first_index;
+            if (count <= until_end) {
+                return {std::span<T>(entries.data() + first_index, count), std::span<T>()};
+            }
+            return {
+                std::span<T>(entries.data() + first_index, until_end), std::span<T>(entries.data(), count - until_end)
+            };
+        }
+
         [[gnu::pure]] [[nodiscard]] static constexpr size_t get_buffer_size() noexcept {
             return BUFFER_SIZE;
         }
     };
+
+    /**
+     * RingBuffer<T, DYNAMIC_SIZE>: capacity chosen at startup, slots mapped outside the object (huge pages by default).
+     * Indexing still uses a mask, so the capacity must be a power of 2.
+     */
+    template<typename T>
+    class RingBuffer<T, DYNAMIC_SIZE> {
+        alignas(CACHE_LINE_SIZE) const char padding_1[CACHE_LINE_SIZE] = {};
+        const size_t buffer_size;
+        const size_t index_mask;
+        const PageSize page_size;
+        HugePageBuffer<T> entries;
+        T *const slots;
+        char padding_2[CACHE_LINE_SIZE * 2] = {};
+
+        std::function<T()> event_factory;
+
+        static size_t require_power_of_two(const size_t buffer_size) {
+            if (buffer_size == 0 || (buffer_size & (buffer_size - 1)) != 0) {
+                throw_or_abort(std::invalid_argument(
+                    "Buffer size must be a power of 2, got " + std::to_string(buffer_size)));
+            }
+            return buffer_size;
+        }
+
+    public:
+        RingBuffer(const size_t buffer_size, std::function<T()> event_creator,
+                   const PageSize page_size = PageSize::TRANSPARENT)
+            : buffer_size(require_power_of_two(buffer_size)), index_mask(buffer_size - 1), page_size(page_size),
+              entries(buffer_size, page_size, event_creator), slots(entries.begin()),
+              event_factory(std::move(event_creator)) {
+        }
+
+        [[gnu::hot]] [[nodiscard]] T &get(const size_t sequence) noexcept {
+            return slots[sequence & index_mask];
+        }
+
+        // same as RingBuffer<T, BUFFER_SIZE>::get_range
+        [[gnu::hot]] [[nodiscard]] std::pair<std::span<T>, std::span<T> > get_range(
+            const size_t first_sequence, const size_t last_sequence) noexcept {
+            const size_t first_index = first_sequence & index_mask;
+            const size_t count = last_sequence - first_sequence + 1;
+            const size_t until_end = buffer_size - first_index;
+            if (count <= until_end) {
+                return {std::span<T>(slots + first_index, count), std::span<T>()};
+            }
+            return {std::span<T>(slots + first_index, until_end), std::span<T>(slots, count - until_end)};
+        }
+
+        [[gnu::pure]] [[nodiscard]] size_t get_buffer_size() const noexcept {
+            return buffer_size;
+        }
+
+        [[nodiscard]] PageSize get_page_size() const noexcept {
+            return page_size;
+        }
+    };
 }
@@ -0,0 +1,143 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include "Sequence.hpp"
+
+/**
+ * Min-of-children aggregation for producers gated by many consumers.
+ * Consumers are split into groups of "fan_out", each group gets a GatingNode holding the minimum of its children,
+ * nodes are grouped again until a single root is left. The producer gates on the root only, so a wrap check reads one
+ * cache line whatever the number of consumers.
+ * The consumers keep the tree up to date: after publishing its own sequence, a consumer refreshes its parent node,
+ * which refreshes its own parent whenever its minimum went up. The cost moves from the producer to the consumers:
+ * "fan_out" sibling reads per level, once per batch.
+ */
+namespace disruptor {
+    class GatingNode final {
+        // minimum of the children, only moves forward
+        Sequence minimum;
+        std::vector<const Sequence *> children;
+        GatingNode *parent = nullptr;
+
+        friend class GatingTree;
+
+        [[nodiscard]] size_t calculate_minimum() const {
+            size_t minimum_sequence = SIZE_MAX;
+            for (const Sequence *child: children) {
+                minimum_sequence = std::min(minimum_sequence, child->get_with_acquire());
+            }
+            return minimum_sequence;
+        }
+
+    public:
+        explicit GatingNode(std::vector<const Sequence *> children) : children(std::move(children)) {
+            minimum.set_with_release(calculate_minimum());
+        }
+
+        GatingNode(const GatingNode &) = delete;
+
+        GatingNode &operator=(const GatingNode &) = delete;
+
+        /**
+         * Recompute the minimum of the children and propagate it up.
+         * A stale child read only gives a lower (safe) minimum, and the children's own refreshes fix it. The full fence
+         * keeps two siblings that publish at the same time from both reading the other's old value.
+         */
+        [[gnu::hot]] void refresh() {
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            const size_t minimum_sequence = calculate_minimum();
+
+            size_t current = minimum.get_with_acquire();
+            while (current < minimum_sequence) {
+                if (minimum.compare_and_set(current, minimum_sequence)) {
+                    if (parent != nullptr) {
+                        parent->refresh();
+                    }
+                    return;
+                }
+                current = minimum.get_with_acquire();
+            }
+        }
+
+        [[nodiscard]] Sequence &get_sequence() {
+            return minimum;
+        }
+    };
+
+
+    class GatingTree final {
+        std::vector<std::unique_ptr<GatingNode> > nodes;
+        std::vector<GatingNode *> consumer_parents;
+        GatingNode *root = nullptr;
+
+    public:
+        explicit GatingTree(const std::vector<std::reference_wrapper<Sequence> > &consumers, const size_t fan_out = 8) {
+            if (consumers.empty()) {
+                throw_or_abort(std::invalid_argument("GatingTree needs at least one consumer"));
+            }
+            if (fan_out < 2) {
+                throw_or_abort(std::invalid_argument("fan_out must be >= 2"));
+            }
+
+            std::vector<const Sequence *> level;
+            for (const auto &consumer: consumers) {
+                level.push_back(&consumer.get());
+            }
+
+            std::vector<GatingNode *> level_nodes;
+            bool leaves = true;
+            do {
+                std::vector<GatingNode *> parents;
+                for (size_t first = 0; first < level.size(); first += fan_out) {
+                    const size_t last = std::min(level.size(), first + fan_out);
+                    nodes.push_back(std::make_unique<GatingNode>(
+                        std::vector<const Sequence *>(level.begin() + first, level.begin() + last)));
+                    GatingNode *parent = nodes.back().get();
+                    parents.push_back(parent);
+
+                    for (size_t i = first; i < last; ++i) {
+                        if (leaves) {
+                            consumer_parents.push_back(parent);
+                        } else {
+                            level_nodes[i]->parent = parent;
+                        }
+                    }
+                }
+
+                level.clear();
+                for (GatingNode *parent: parents) {
+                    level.push_back(&parent->minimum);
+                }
+                level_nodes = std::move(parents);
+                leaves = false;
+            } while (level.size() > 1);
+
+            root = level_nodes.front();
+        }
+
+        // the only sequence the producer has to gate on
+        [[nodiscard]] Sequence &get_root() {
+            return root->minimum;
+        }
+
+        // node the consumer at "consumer_index" (order of the constructor) refreshes after each batch
+        [[nodiscard]] GatingNode &get_parent_of(const size_t consumer_index) {
+            return *consumer_parents.at(consumer_index);
+        }
+
+        [[nodiscard]] size_t get_depth() const {
+            size_t depth = 0;
+            for (const GatingNode *node = consumer_parents.front(); node != nullptr; node = node->parent) {
+                ++depth;
+            }
+            return depth;
+        }
+    };
+}
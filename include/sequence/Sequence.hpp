@@ -28,6 +28,11 @@ namespace disruptor {
             return value;
         }
 
+        // where the value lives, so a group can gather many sequences with one instruction
+        [[nodiscard]] const size_t *get_value_address() const {
+            return &value;
+        }
+
         [[gnu::hot]] void set_with_release(const size_t newValue) {
             std::atomic_thread_fence(std::memory_order_release);
             value = newValue;
@@ -47,5 +52,17 @@ namespace disruptor {
             );
             return origin_value;
         }
+
+        // atomically replace the value with "new_value" if it still equals "expected_value"
+        [[gnu::hot]] bool compare_and_set(size_t expected_value, const size_t new_value) {
+            bool swapped;
+            __asm__ __volatile__ (
+                "lock cmpxchgq %3, %1"
+                : "=@ccz" (swapped), "+m" (value), "+a" (expected_value)
+                : "r" (new_value)
+                : "memory"
+            );
+            return swapped;
+        }
     };
 }
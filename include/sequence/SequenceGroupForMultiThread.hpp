@@ -6,12 +6,15 @@
 #include <format>
 
 #include "Sequence.hpp"
+#include "SequenceSnapshot.hpp"
+#include "../common/Simd.hpp"
 
 namespace disruptor {
     template<size_t NUMBER_DEPENDENT_SEQUENCES>
     class SequenceGroupForMultiThread final {
         alignas(CACHE_LINE_SIZE) const char padding_1[CACHE_LINE_SIZE] = {};
         std::array<Sequence *, NUMBER_DEPENDENT_SEQUENCES> sequences; // Contains an array of pointers to sequences
+        std::array<const size_t *, NUMBER_DEPENDENT_SEQUENCES> values; // address of each value, gathered by get()
         const char padding_2[CACHE_LINE_SIZE * 2] = {};
 
     public:
@@ -22,6 +25,7 @@ namespace disruptor {
         explicit SequenceGroupForMultiThread() {
             for (std::size_t i = 0; i < NUMBER_DEPENDENT_SEQUENCES; ++i) {
                 sequences[i] = nullptr;
+                values[i] = nullptr;
             }
         }
 
@@ -29,17 +33,26 @@ namespace disruptor {
             assert(dependent_sequences.size() == NUMBER_DEPENDENT_SEQUENCES && std::format("Require {} sequences", NUMBER_DEPENDENT_SEQUENCES).c_str());
             std::size_t i = 0;
             for (auto &ref: dependent_sequences) {
-                sequences[i++] = &ref.get();
+                sequences[i] = &ref.get();
+                values[i] = ref.get().get_value_address();
+                ++i;
             }
         }
 
-        [[nodiscard]] size_t get() {
-            size_t minimum_sequence = INT64_MAX;
-            for (const auto &sequence: sequences) {
-                const size_t value = sequence->get_with_acquire();
-                minimum_sequence = std::min(minimum_sequence, value);
+        [[nodiscard]] size_t get() const {
+            if constexpr (NUMBER_DEPENDENT_SEQUENCES >= Simd::GATHER_THRESHOLD) {
+                size_t index;
+                const size_t minimum_sequence = Simd::min_of_pointed(values.data(), values.size(), index);
+                std::atomic_thread_fence(std::memory_order_acquire);
+                return minimum_sequence;
+            } else {
+                size_t minimum_sequence = INT64_MAX;
+                for (const auto &sequence: sequences) {
+                    const size_t value = sequence->get_with_acquire();
+                    minimum_sequence = std::min(minimum_sequence, value);
+                }
+                return minimum_sequence;
             }
-            return minimum_sequence;
         }
     };
 
@@ -67,4 +80,34 @@ namespace disruptor {
             return sequence->get_with_acquire();
         }
     };
+
+    /**
+     * Gating sequences added and removed while producers run, see SequenceSnapshot.
+     * Producers pass their cursor as the upper bound so an empty group does not report "no limit".
+     */
+    template<>
+    class SequenceGroupForMultiThread<DYNAMIC_SIZE> final {
+        SequenceSnapshot sequences;
+
+    public:
+        void set_sequences(const std::initializer_list<std::reference_wrapper<Sequence> > dependent_sequences) {
+            sequences.set(dependent_sequences);
+        }
+
+        void add(Sequence &sequence) {
+            sequences.add(sequence);
+        }
+
+        bool remove(const Sequence &sequence) {
+            return sequences.remove(sequence);
+        }
+
+        [[gnu::hot]] [[nodiscard]] size_t get(const size_t upper_bound) const {
+            return sequences.minimum(upper_bound);
+        }
+
+        [[nodiscard]] size_t size() const {
+            return sequences.size();
+        }
+    };
 }
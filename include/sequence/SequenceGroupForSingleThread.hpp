@@ -1,11 +1,14 @@
 #pragma once
 
+#include <algorithm>
 #include <string>
 #include <cassert>
 #include <array>
 #include <format>
 
 #include "Sequence.hpp"
+#include "SequenceSnapshot.hpp"
+#include "../common/Simd.hpp"
 
 namespace disruptor {
     template<size_t NUMBER_DEPENDENT_SEQUENCES>
@@ -17,16 +20,22 @@ namespace disruptor {
         const char padding_3[CACHE_LINE_SIZE] = {};
 
         std::array<Sequence *, NUMBER_DEPENDENT_SEQUENCES> sequences; // Contains an array of pointers to sequences
+        std::array<const size_t *, NUMBER_DEPENDENT_SEQUENCES> values; // address of each value, gathered on a refresh
         const char padding_4[CACHE_LINE_SIZE * 2] = {};
 
         void calculate_cache() {
             size_t minimum_sequence = INT64_MAX;
             size_t minimum_index = 0;
-            for (size_t k = 0; k < sequences.size(); k++) {
-                const size_t value = sequences[k]->get_with_acquire();
-                if (value < minimum_sequence) {
-                    minimum_sequence = value;
-                    minimum_index = k;
+            if constexpr (NUMBER_DEPENDENT_SEQUENCES >= Simd::GATHER_THRESHOLD) {
+                minimum_sequence = Simd::min_of_pointed(values.data(), values.size(), minimum_index);
+                std::atomic_thread_fence(std::memory_order_acquire);
+            } else {
+                for (size_t k = 0; k < sequences.size(); k++) {
+                    const size_t value = sequences[k]->get_with_acquire();
+                    if (value < minimum_sequence) {
+                        minimum_sequence = value;
+                        minimum_index = k;
+                    }
                 }
             }
             value_min_sequence_cache = minimum_sequence;
@@ -42,6 +51,7 @@ namespace disruptor {
         explicit SequenceGroupForSingleThread() {
             for (std::size_t i = 0; i < NUMBER_DEPENDENT_SEQUENCES; ++i) {
                 sequences[i] = nullptr;
+                values[i] = nullptr;
             }
         }
 
@@ -51,7 +61,9 @@ namespace disruptor {
                     NUMBER_DEPENDENT_SEQUENCES).c_str());
             std::size_t i = 0;
             for (auto &ref: dependent_sequences) {
-                sequences[i++] = &ref.get();
+                sequences[i] = &ref.get();
+                values[i] = ref.get().get_value_address();
+                ++i;
             }
 
             calculate_cache();
@@ -68,6 +80,12 @@ namespace disruptor {
                 return value_min_sequence_cache;
             }
 
+            if constexpr (NUMBER_DEPENDENT_SEQUENCES >= Simd::GATHER_THRESHOLD) {
+                // the slowest sequence moved on, gather all of them again
+                calculate_cache();
+                return value_min_sequence_cache;
+            }
+
             size_t index = 0;
             size_t minimum_sequence = INT64_MAX;
             for (size_t i = 0; i < sequences.size(); i++) {
@@ -90,6 +108,15 @@ namespace disruptor {
 
             return minimum_sequence;
         }
+
+        // minimum of the sequences for a thread other than the owner, the owner's cache is left as it is
+        [[nodiscard]] size_t peek() const {
+            size_t minimum_sequence = INT64_MAX;
+            for (const Sequence *sequence: sequences) {
+                minimum_sequence = std::min(minimum_sequence, sequence->get_with_acquire());
+            }
+            return minimum_sequence;
+        }
     };
 
     template<>
@@ -127,5 +154,57 @@ namespace disruptor {
         [[gnu::hot]] [[nodiscard]] size_t get_cache() const {
             return cached_min_sequence;
         }
+
+        // same as get() for a thread other than the owner, the owner's cache is left as it is
+        [[nodiscard]] size_t peek() const {
+            return sequence->get_with_acquire();
+        }
+    };
+
+    /**
+     * Gating sequences added and removed while the producer runs, see SequenceSnapshot.
+     * The producer passes its published cursor as the upper bound: with it an empty group never lets the cached
+     * minimum get ahead of a consumer added later (new consumers start at the cursor).
+     */
+    template<>
+    class SequenceGroupForSingleThread<DYNAMIC_SIZE> final {
+        alignas(CACHE_LINE_SIZE) const char padding_1[CACHE_LINE_SIZE] = {};
+        size_t value_min_sequence_cache{0};
+        const char padding_2[CACHE_LINE_SIZE - sizeof(size_t)] = {};
+        const char padding_3[CACHE_LINE_SIZE] = {};
+
+        SequenceSnapshot sequences;
+
+    public:
+        void set_sequences(const std::initializer_list<std::reference_wrapper<Sequence> > dependent_sequences) {
+            sequences.set(dependent_sequences);
+        }
+
+        void add(Sequence &sequence) {
+            sequences.add(sequence);
+        }
+
+        bool remove(const Sequence &sequence) {
+            return sequences.remove(sequence);
+        }
+
+        // get the most recent cached value
+        [[gnu::hot]] [[nodiscard]] size_t get_cache() const {
+            return value_min_sequence_cache;
+        }
+
+        [[gnu::hot]] [[nodiscard]] size_t get(const size_t upper_bound) {
+            value_min_sequence_cache = sequences.minimum(upper_bound);
+            return value_min_sequence_cache;
+        }
+
+        // same as get() for a thread other than the owner, the owner's cache is left as it is
+        [[nodiscard]] size_t peek(const size_t upper_bound) const {
+            return sequences.minimum(upper_bound);
+        }
+
+        [[nodiscard]] size_t size() const {
+            return sequences.size();
+        }
     };
 }
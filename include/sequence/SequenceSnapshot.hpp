@@ -0,0 +1,115 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <vector>
+
+#include "Sequence.hpp"
+
+/**
+ * Set of gating sequences that can change while producers read it (RCU style).
+ * Readers load the current snapshot with one acquire load and never wait. Writers copy the snapshot, change the copy
+ * and swap it in with a CAS, retrying if another writer got there first.
+ * A replaced snapshot may still be read by a producer, so it is only freed together with the set: each snapshot keeps
+ * a link to the one it replaced. Consumers coming and going a few times a day cost a few bytes each.
+ *
+ * Attaching a consumer to a running sequencer is a store buffering handshake: the sequencer stores its cursor then
+ * loads the snapshot, the thread adding the consumer swaps the snapshot in then loads the cursor to place the consumer.
+ * Acquire/release alone lets both sides read the old value (on x86 the cursor store can still sit in the store
+ * buffer), so the producer would keep gating on the old set while the consumer starts behind the cursor the producer
+ * has already moved past. The sequencers put a seq_cst fence between the two operations on both sides: either the
+ * producer sees the new snapshot, or the consumer is placed at or after every cursor value the producer has gated on.
+ */
+namespace disruptor {
+    class SequenceSnapshot final {
+        struct Snapshot {
+            std::vector<Sequence *> sequences;
+            const Snapshot *previous = nullptr;
+        };
+
+        alignas(CACHE_LINE_SIZE) const char padding_1[CACHE_LINE_SIZE] = {};
+        std::atomic<const Snapshot *> current;
+        const char padding_2[CACHE_LINE_SIZE - sizeof(std::atomic<const Snapshot *>)] = {};
+        const char padding_3[CACHE_LINE_SIZE] = {};
+
+        // "change" edits the copy of the current sequences, returns false to leave the set as it is
+        template<typename Change>
+        bool update(Change &&change) {
+            const Snapshot *expected = current.load(std::memory_order_acquire);
+            while (true) {
+                auto *next = new Snapshot{expected->sequences, expected};
+                if (!change(next->sequences)) {
+                    delete next;
+                    return false;
+                }
+                if (current.compare_exchange_weak(expected, next, std::memory_order_acq_rel,
+                                                  std::memory_order_acquire)) {
+                    return true;
+                }
+                delete next;
+            }
+        }
+
+    public:
+        SequenceSnapshot() : current(new Snapshot{}) {
+        }
+
+        ~SequenceSnapshot() {
+            const Snapshot *snapshot = current.load(std::memory_order_acquire);
+            while (snapshot != nullptr) {
+                const Snapshot *previous = snapshot->previous;
+                delete snapshot;
+                snapshot = previous;
+            }
+        }
+
+        SequenceSnapshot(const SequenceSnapshot &) = delete;
+
+        SequenceSnapshot &operator=(const SequenceSnapshot &) = delete;
+
+        void set(const std::initializer_list<std::reference_wrapper<Sequence> > sequences) {
+            update([&sequences](std::vector<Sequence *> &next) {
+                next.clear();
+                for (const auto &sequence: sequences) {
+                    next.push_back(&sequence.get());
+                }
+                return true;
+            });
+        }
+
+        void add(Sequence &sequence) {
+            update([&sequence](std::vector<Sequence *> &next) {
+                next.push_back(&sequence);
+                return true;
+            });
+        }
+
+        bool remove(const Sequence &sequence) {
+            return update([&sequence](std::vector<Sequence *> &next) {
+                const auto found = std::find(next.begin(), next.end(), &sequence);
+                if (found == next.end()) {
+                    return false;
+                }
+                next.erase(found);
+                return true;
+            });
+        }
+
+        // minimum of the current sequences, "upper_bound" when there is none lower (or none at all)
+        [[gnu::hot]] [[nodiscard]] size_t minimum(const size_t upper_bound) const {
+            const Snapshot *snapshot = current.load(std::memory_order_acquire);
+            size_t minimum_sequence = upper_bound;
+            for (const Sequence *sequence: snapshot->sequences) {
+                minimum_sequence = std::min(minimum_sequence, sequence->get_with_acquire());
+            }
+            return minimum_sequence;
+        }
+
+        [[nodiscard]] size_t size() const {
+            return current.load(std::memory_order_acquire)->sequences.size();
+        }
+    };
+}
@@ -1,18 +1,39 @@
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+
 #include "../sequence/SequenceGroupForMultiThread.hpp"
 #include "Sequencer.hpp"
+#include "common/Simd.hpp"
 #include "common/Util.hpp"
 #include "ring_buffer/RingBuffer.hpp"
 
 /**
  * cursor: the highest sequence number that has been claimed by the producer but not yet published.
  * availableBuffer: store the corresponding rotation count for the position in the ring buffer to determine whether a sequence has been published.
+ * The rotation counts are packed 32-bit flags (16 slots per cache line), a slot only has to tell its current lap from the
+ * previous one so the truncation never matters. Producers write neighbouring slots anyway: each claims a contiguous range.
  */
 namespace disruptor {
     template<typename T, size_t RING_BUFFER_SIZE, size_t NUMBER_GATING_SEQUENCES>
     class MultiProducerSequencer final : public Sequencer {
-        alignas(CACHE_LINE_SIZE) Sequence cursor{Util::calculate_initial_value_sequence(RING_BUFFER_SIZE)};
+        using AvailabilityFlag = std::atomic<uint32_t>;
+        static_assert(sizeof(AvailabilityFlag) == sizeof(uint32_t) && AvailabilityFlag::is_always_lock_free);
+
+        static constexpr uint32_t UNPUBLISHED_FLAG = UINT32_MAX;
+
+        // rings sized at startup keep their availability flags next to their entries, on huge pages
+        using AvailableBuffer = std::conditional_t<RING_BUFFER_SIZE == DYNAMIC_SIZE, HugePageBuffer<AvailabilityFlag>,
+            std::array<AvailabilityFlag, RING_BUFFER_SIZE> >;
+
+        alignas(CACHE_LINE_SIZE) Sequence cursor;
+
+        // lowest gating sequence seen by any producer, only moves forward. Producers read the consumers' sequences
+        // only when a claim would wrap past it
+        alignas(CACHE_LINE_SIZE) Sequence gating_sequence_cache;
 
         alignas(CACHE_LINE_SIZE) const char padding_1[CACHE_LINE_SIZE] = {};
         const size_t index_mask;
@@ -21,18 +42,37 @@ namespace disruptor {
         const char padding_2[CACHE_LINE_SIZE - sizeof(std::atomic<size_t>) * 2] = {};
         const char padding_3[CACHE_LINE_SIZE] = {};
 
-        std::array<Sequence, RING_BUFFER_SIZE> available_buffer;
+        alignas(CACHE_LINE_SIZE) AvailableBuffer available_buffer;
         const char padding_4[CACHE_LINE_SIZE * 2] = {};
 
         const RingBuffer<T, RING_BUFFER_SIZE> &ring_buffer;
         SequenceGroupForMultiThread<NUMBER_GATING_SEQUENCES> gating_sequences;
 
+        // wakes consumers parked by a blocking wait strategy
+        BlockingSignal blocking_signal;
+
+        // how the producer backs off while the ring is full
+        BackoffPolicy backoff_policy;
+
+        static AvailableBuffer create_available_buffer(const RingBuffer<T, RING_BUFFER_SIZE> &ring_buffer) {
+            if constexpr (RING_BUFFER_SIZE == DYNAMIC_SIZE) {
+                return AvailableBuffer(ring_buffer.get_buffer_size(), ring_buffer.get_page_size(), [] {
+                    return AvailabilityFlag{UNPUBLISHED_FLAG};
+                });
+            } else {
+                return AvailableBuffer{};
+            }
+        }
+
     public:
         explicit MultiProducerSequencer(const RingBuffer<T, RING_BUFFER_SIZE> &ring_buffer_ptr)
-            : index_mask(ring_buffer_ptr.get_buffer_size() - 1),
-              index_shift(Util::log_2(ring_buffer_ptr.get_buffer_size())), ring_buffer(ring_buffer_ptr) {
-            for (auto &seq: available_buffer) {
-                seq.set_with_release(-1);
+            : cursor(Util::calculate_initial_value_sequence(ring_buffer_ptr.get_buffer_size())),
+              gating_sequence_cache(Util::calculate_initial_value_sequence(ring_buffer_ptr.get_buffer_size())),
+              index_mask(ring_buffer_ptr.get_buffer_size() - 1),
+              index_shift(Util::log_2(ring_buffer_ptr.get_buffer_size())),
+              available_buffer(create_available_buffer(ring_buffer_ptr)), ring_buffer(ring_buffer_ptr) {
+            for (auto &flag: available_buffer) {
+                flag.store(UNPUBLISHED_FLAG, std::memory_order_release);
             }
         }
 
@@ -44,40 +84,54 @@ namespace disruptor {
             const size_t buffer_size = ring_buffer.get_buffer_size();
 
             if (n < 1 || n > buffer_size) [[unlikely]] {
-                throw std::invalid_argument("n must be > 0 and < bufferSize");
+                throw_or_abort(std::invalid_argument("n must be > 0 and < bufferSize"));
             }
 
             const size_t current_sequence = cursor.get_and_add(n);
             const size_t next_sequence = current_sequence + n;
             const size_t wrap_point = next_sequence - buffer_size;
 
-            int wait_counter = 0;
-
-            while (gating_sequences.get() < wrap_point) {
-                Util::adaptive_wait(wait_counter);
+            if (gating_sequence_cache.get_with_acquire() < wrap_point) [[unlikely]] {
+                int wait_counter = 0;
+                size_t minimum_gating_sequence;
+                while ((minimum_gating_sequence = get_minimum_gating_sequence()) < wrap_point) {
+                    Util::adaptive_wait(wait_counter, backoff_policy);
+                }
+                update_gating_sequence_cache(minimum_gating_sequence);
             }
 
             return next_sequence;
         }
 
+        // several producers may refresh the cache at once, keep the highest value
+        void update_gating_sequence_cache(const size_t minimum_gating_sequence) {
+            size_t cached = gating_sequence_cache.get_with_acquire();
+            while (cached < minimum_gating_sequence
+                   && !gating_sequence_cache.compare_and_set(cached, minimum_gating_sequence)) {
+                cached = gating_sequence_cache.get_with_acquire();
+            }
+        }
+
         [[gnu::hot]] void publish(const size_t sequence) override {
             set_available(sequence);
+            blocking_signal.signal_when_blocking();
         }
 
         void publish(const size_t low, const size_t high) override {
             for (size_t i = low; i <= high; ++i) {
                 set_available(i);
             }
+            blocking_signal.signal_when_blocking();
         }
 
         void set_available(const size_t sequence) {
             const size_t index = calculate_index(sequence);
-            const size_t flag = calculate_availability_flag(sequence);
-            available_buffer[index].set_with_release(flag);
+            const uint32_t flag = calculate_availability_flag(sequence);
+            available_buffer[index].store(flag, std::memory_order_release);
         }
 
-        [[gnu::pure]] [[nodiscard]] size_t calculate_availability_flag(const size_t sequence) const {
-            return sequence >> index_shift;
+        [[gnu::pure]] [[nodiscard]] uint32_t calculate_availability_flag(const size_t sequence) const {
+            return static_cast<uint32_t>(sequence >> index_shift);
         }
 
         [[gnu::pure]] [[nodiscard]] size_t calculate_index(const size_t sequence) const {
@@ -86,26 +140,99 @@ namespace disruptor {
 
         [[gnu::hot]] [[nodiscard]] bool is_available(const size_t sequence) const override {
             const size_t index = calculate_index(sequence);
-            const size_t flag = calculate_availability_flag(sequence);
-            return available_buffer[index].get_with_acquire() == flag;
+            const uint32_t flag = calculate_availability_flag(sequence);
+            return available_buffer[index].load(std::memory_order_acquire) == flag;
         }
 
         [[nodiscard]] Sequence &get_cursor() {
             return cursor;
         }
 
+        [[nodiscard]] BlockingSignal &get_blocking_signal() override {
+            return blocking_signal;
+        }
+
+        // lowest sequence processed by every gating consumer
+        [[nodiscard]] size_t get_minimum_gating_sequence() {
+            if constexpr (NUMBER_GATING_SEQUENCES == DYNAMIC_SIZE) {
+                // cursor updates before the snapshot load, pairs with add_gating_sequence (see SequenceSnapshot)
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                return gating_sequences.get(cursor.get_with_acquire());
+            } else {
+                return gating_sequences.get();
+            }
+        }
+
+        // same as get_minimum_gating_sequence, const: the producers keep no cache in the group
+        [[nodiscard]] size_t read_minimum_gating_sequence() const {
+            if constexpr (NUMBER_GATING_SEQUENCES == DYNAMIC_SIZE) {
+                return gating_sequences.get(cursor.get_with_acquire());
+            } else {
+                return gating_sequences.get();
+            }
+        }
+
+        /**
+         * Attach a consumer while the ring runs (NUMBER_GATING_SEQUENCES == DYNAMIC_SIZE). The consumer's sequence is
+         * moved to the cursor: it only sees events claimed from now on. Start the consumer after this returns.
+         */
+        void add_gating_sequence(Sequence &sequence) requires (NUMBER_GATING_SEQUENCES == DYNAMIC_SIZE) {
+            sequence.set_with_release(cursor.get_with_acquire());
+            gating_sequences.add(sequence);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            // producers may have claimed while the new set was swapped in
+            sequence.set_with_release(cursor.get_with_acquire());
+        }
+
+        // detach a consumer, it no longer holds producers back. Returns false if it was not gating this sequencer
+        bool remove_gating_sequence(const Sequence &sequence) requires (NUMBER_GATING_SEQUENCES == DYNAMIC_SIZE) {
+            return gating_sequences.remove(sequence);
+        }
+
+        // only call before producers start; ParkMode::BLOCK falls back to sleeping as consumers never signal producers
+        void set_backoff_policy(const BackoffPolicy &policy) {
+            backoff_policy = policy;
+        }
+
         /**
          * Retrieve the highest sequence that has been published for the consumer to process.
          * In a multi-producer environment, it's possible that sequence 10 has already been published by producer A, while sequence 9, handled by producer B, is still being processed.
+         * The flags are compared a vector at a time, in runs that stop where the ring wraps and the expected lap changes.
+         * The vector scan reads the atomics as plain words: that only holds where std::atomic<uint32_t> is a bare
+         * lock-free word and an aligned 32-bit load never tears, even as a lane of a wider load (x86). Each lane is
+         * then the old or the new flag, and the acquire fence after the scan orders the slot reads that follow.
+         * Elsewhere the flags are loaded one at a time through the atomic.
          */
         [[nodiscard]] size_t get_highest_published_sequence(const size_t lower_bound,
                                                             const size_t available_sequence) const override {
+#if defined(__x86_64__) || defined(__i386__)
+            static_assert(sizeof(AvailabilityFlag) == sizeof(uint32_t) &&
+                          alignof(AvailabilityFlag) == alignof(uint32_t) && AvailabilityFlag::is_always_lock_free);
+            const auto *flags = reinterpret_cast<const uint32_t *>(&available_buffer[0]);
+            const size_t buffer_size = index_mask + 1;
+
+            size_t sequence = lower_bound;
+            while (sequence <= available_sequence) {
+                const size_t index = calculate_index(sequence);
+                const size_t count = std::min(available_sequence - sequence + 1, buffer_size - index);
+                const size_t published = Simd::find_first_not_equal(flags + index, count,
+                                                                    calculate_availability_flag(sequence));
+                if (published < count) {
+                    std::atomic_thread_fence(std::memory_order_acquire);
+                    return sequence + published - 1;
+                }
+                sequence += count;
+            }
+            std::atomic_thread_fence(std::memory_order_acquire);
+            return available_sequence;
+#else
             for (size_t sequence = lower_bound; sequence <= available_sequence; ++sequence) {
                 if (!is_available(sequence)) {
                     return sequence - 1;
                 }
             }
             return available_sequence;
+#endif
         }
     };
 }
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "../sequence/Sequence.hpp"
+#include "../wait_strategy/BlockingSignal.hpp"
 
 namespace disruptor {
     class Sequencer {
@@ -21,5 +22,10 @@ namespace disruptor {
         virtual void publish(size_t sequence) = 0;
 
         virtual void publish(size_t lo, size_t hi) = 0;
+
+        /**
+         * Signal used by blocking wait strategies to park consumers until the next publish
+         */
+        [[nodiscard]] virtual BlockingSignal &get_blocking_signal() = 0;
     };
 }
@@ -3,6 +3,8 @@
 #include "Sequencer.hpp"
 #include "../common/Common.hpp"
 #include "../common/Util.hpp"
+#include "../ring_buffer/RingBuffer.hpp"
+#include <atomic>
 #include <unordered_map>
 #include <cassert>
 
@@ -12,23 +14,36 @@ namespace disruptor {
     template<typename T, size_t RING_BUFFER_SIZE, size_t NUMBER_GATING_SEQUENCES>
     class SingleProducerSequencer final : public Sequencer {
         // manage the sequences that have been published.
-        alignas(CACHE_LINE_SIZE) Sequence cursor{Util::calculate_initial_value_sequence(RING_BUFFER_SIZE)};
+        alignas(CACHE_LINE_SIZE) Sequence cursor;
 
         // the most recent sequence has been claimed by the publisher.
-        size_t latest_claimed_sequence{Util::calculate_initial_value_sequence(RING_BUFFER_SIZE)};
+        size_t latest_claimed_sequence;
         const char padding_1[CACHE_LINE_SIZE - sizeof(size_t)] = {};
         const char padding_2[CACHE_LINE_SIZE] = {};
 
         const RingBuffer<T, RING_BUFFER_SIZE> &ring_buffer;
         SequenceGroupForSingleThread<NUMBER_GATING_SEQUENCES> gating_sequences;
 
+        // wakes consumers parked by a blocking wait strategy
+        BlockingSignal blocking_signal;
+
+        // how the producer backs off while the ring is full
+        BackoffPolicy backoff_policy;
+
         bool same_thread() {
             return ProducerThreadAssertion::is_same_thread_producing_to(this);
         }
 
     public:
         explicit
-        SingleProducerSequencer(const RingBuffer<T, RING_BUFFER_SIZE> &ring_buffer) : ring_buffer(ring_buffer) {
+        SingleProducerSequencer(const RingBuffer<T, RING_BUFFER_SIZE> &ring_buffer)
+            : cursor(Util::calculate_initial_value_sequence(ring_buffer.get_buffer_size())),
+              latest_claimed_sequence(Util::calculate_initial_value_sequence(ring_buffer.get_buffer_size())),
+              ring_buffer(ring_buffer) {
+        }
+
+        ~SingleProducerSequencer() override {
+            ProducerThreadAssertion::forget(this);
         }
 
         void add_gating_sequences(const std::initializer_list<std::reference_wrapper<Sequence> > sequences) override {
@@ -40,7 +55,7 @@ namespace disruptor {
             const size_t buffer_size = ring_buffer.get_buffer_size();
 
             if (n < 1 || n > buffer_size) [[unlikely]] {
-                throw std::invalid_argument("n must be > 0 and < bufferSize");
+                throw_or_abort(std::invalid_argument("n must be > 0 and < bufferSize"));
             }
 
             const size_t local_next_value = latest_claimed_sequence;
@@ -49,8 +64,8 @@ namespace disruptor {
 
             if (gating_sequences.get_cache() < wrap_point) {
                 int wait_counter = 0;
-                while (wrap_point > gating_sequences.get()) {
-                    Util::adaptive_wait(wait_counter);
+                while (wrap_point > get_minimum_gating_sequence()) {
+                    Util::adaptive_wait(wait_counter, backoff_policy);
                 }
             }
 
@@ -61,6 +76,7 @@ namespace disruptor {
 
         [[gnu::hot]] void publish(const size_t sequence) override {
             cursor.set_with_release(sequence);
+            blocking_signal.signal_when_blocking();
         }
 
         void publish(const size_t lo, const size_t hi) override {
@@ -81,6 +97,52 @@ namespace disruptor {
             return cursor;
         }
 
+        [[nodiscard]] BlockingSignal &get_blocking_signal() override {
+            return blocking_signal;
+        }
+
+        // lowest sequence processed by every gating consumer, only from the producer thread
+        [[nodiscard]] size_t get_minimum_gating_sequence() {
+            if constexpr (NUMBER_GATING_SEQUENCES == DYNAMIC_SIZE) {
+                // cursor updates before the snapshot load, pairs with add_gating_sequence (see SequenceSnapshot)
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                return gating_sequences.get(cursor.get_with_acquire());
+            } else {
+                return gating_sequences.get();
+            }
+        }
+
+        // same minimum from any thread (monitoring): reads the consumers' sequences, not the producer's cache
+        [[nodiscard]] size_t read_minimum_gating_sequence() const {
+            if constexpr (NUMBER_GATING_SEQUENCES == DYNAMIC_SIZE) {
+                return gating_sequences.peek(cursor.get_with_acquire());
+            } else {
+                return gating_sequences.peek();
+            }
+        }
+
+        /**
+         * Attach a consumer while the ring runs (NUMBER_GATING_SEQUENCES == DYNAMIC_SIZE). The consumer's sequence is
+         * moved to the cursor: it only sees events published from now on. Start the consumer after this returns.
+         */
+        void add_gating_sequence(Sequence &sequence) requires (NUMBER_GATING_SEQUENCES == DYNAMIC_SIZE) {
+            sequence.set_with_release(cursor.get_with_acquire());
+            gating_sequences.add(sequence);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            // the producer may have published while the new set was swapped in
+            sequence.set_with_release(cursor.get_with_acquire());
+        }
+
+        // detach a consumer, it no longer holds the producer back. Returns false if it was not gating this sequencer
+        bool remove_gating_sequence(const Sequence &sequence) requires (NUMBER_GATING_SEQUENCES == DYNAMIC_SIZE) {
+            return gating_sequences.remove(sequence);
+        }
+
+        // only call before producers start; ParkMode::BLOCK falls back to sleeping as consumers never signal producers
+        void set_backoff_policy(const BackoffPolicy &policy) {
+            backoff_policy = policy;
+        }
+
         /**
          * Only used when assertions are enabled.
          */
@@ -99,6 +161,12 @@ namespace disruptor {
 
                 return PRODUCERS[single_producer_sequencer] == currentThread;
             }
+
+            // a sequencer created later at the same address may be used by another thread
+            static void forget(SingleProducerSequencer *single_producer_sequencer) {
+                std::lock_guard lock(producers_mutex);
+                PRODUCERS.erase(single_producer_sequencer);
+            }
         };
     };
 }
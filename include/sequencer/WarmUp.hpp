@@ -0,0 +1,42 @@
+#pragma once
+
+#include "../common/Util.hpp"
+#include "../ring_buffer/RingBuffer.hpp"
+
+/**
+ * Get a freshly built ring ready for live traffic: run_laps pushes synthetic events through the real pipeline so
+ * caches, TLBs and branch predictors of the producer, the processors and the handlers are warm. Handlers see these
+ * events, "fill" should mark them so the handlers can skip their side effects.
+ * Sequences only move forward, so nothing has to be reset afterwards.
+ * Page faults need no warm-up: an array-backed ring (and its sequencer, cursor and availability flags) is already
+ * resident once constructed, every entry and flag is written by the constructors, and a DYNAMIC_SIZE ring's
+ * HugePageBuffer mappings are populated when they are mapped.
+ */
+namespace disruptor {
+    class WarmUp {
+    public:
+        /**
+         * Publish "laps" * buffer size synthetic events one by one, then wait until the gating sequences (the consumers
+         * at the end of the pipeline) have processed all of them. For a SingleProducerSequencer call it from the thread
+         * that will produce.
+         * @param fill writes a synthetic event into the claimed slot: fill(event, sequence)
+         */
+        template<typename T, size_t BUFFER_SIZE, typename SequencerType, typename Fill>
+        static void run_laps(RingBuffer<T, BUFFER_SIZE> &ring_buffer, SequencerType &sequencer, const size_t laps,
+                             Fill &&fill) {
+            const size_t events = laps * ring_buffer.get_buffer_size();
+            size_t last_published = sequencer.get_cursor().get_with_acquire();
+
+            for (size_t i = 0; i < events; ++i) {
+                last_published = sequencer.next(1);
+                fill(ring_buffer.get(last_published), last_published);
+                sequencer.publish(last_published);
+            }
+
+            int wait_counter = 0;
+            while (sequencer.get_minimum_gating_sequence() < last_published) {
+                Util::adaptive_wait(wait_counter);
+            }
+        }
+    };
+}
@@ -0,0 +1,156 @@
+#pragma once
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+/**
+ * Snapshot of the machine layout read from /sys/devices/system/cpu:
+ * cpuN/topology/{core_id,physical_package_id}, cpuN/cache/indexK/{level,type,shared_cpu_list} and the cpuN/nodeX links.
+ * Caches are identified by the lowest cpu sharing them, so two cpus share a cache iff the ids are equal.
+ */
+namespace disruptor {
+    struct CpuInfo {
+        int cpu = 0;
+        int core_id = 0; // unique across packages, SMT siblings have the same value
+        int package_id = 0;
+        int numa_node = 0;
+        int l2_id = 0;
+        int llc_id = 0; // last level cache, usually the L3 of a package or CCX
+    };
+
+    class CpuTopology {
+        std::vector<CpuInfo> cpus;
+
+        static std::string read_first_line(const std::filesystem::path &path) {
+            std::ifstream file(path);
+            std::string line;
+            std::getline(file, line);
+            return line;
+        }
+
+        static int read_int(const std::filesystem::path &path, const int fallback) {
+            const std::string line = read_first_line(path);
+            if (line.empty()) {
+                return fallback;
+            }
+            return std::stoi(line);
+        }
+
+        static int find_numa_node(const std::filesystem::path &cpu_path) {
+            std::error_code error;
+            for (const auto &entry: std::filesystem::directory_iterator(cpu_path, error)) {
+                const std::string name = entry.path().filename().string();
+                if (name.size() > 4 && name.starts_with("node")) {
+                    return std::stoi(name.substr(4));
+                }
+            }
+            return 0;
+        }
+
+        // fills l2_id and llc_id, cpus without cache information share nothing but themselves
+        static void read_caches(const std::filesystem::path &cpu_path, CpuInfo &info) {
+            info.l2_id = info.cpu;
+            info.llc_id = info.cpu;
+            int llc_level = 0;
+
+            std::error_code error;
+            for (const auto &entry: std::filesystem::directory_iterator(cpu_path / "cache", error)) {
+                if (!entry.path().filename().string().starts_with("index")) {
+                    continue;
+                }
+                if (read_first_line(entry.path() / "type") == "Instruction") {
+                    continue;
+                }
+                const int level = read_int(entry.path() / "level", 0);
+                const std::vector<int> shared = parse_cpu_list(read_first_line(entry.path() / "shared_cpu_list"));
+                const int cache_id = shared.empty() ? info.cpu : shared.front();
+
+                if (level == 2) {
+                    info.l2_id = cache_id;
+                }
+                if (level > llc_level) {
+                    llc_level = level;
+                    info.llc_id = cache_id;
+                }
+            }
+        }
+
+    public:
+        explicit CpuTopology(std::vector<CpuInfo> cpus) : cpus(std::move(cpus)) {
+            std::sort(this->cpus.begin(), this->cpus.end(), [](const CpuInfo &a, const CpuInfo &b) {
+                return a.cpu < b.cpu;
+            });
+        }
+
+        // read the online cpus of this machine, or of a copy of the sysfs tree rooted at "root"
+        static CpuTopology read(const std::filesystem::path &root = "/sys/devices/system/cpu") {
+            const std::vector<int> online = parse_cpu_list(read_first_line(root / "online"));
+            if (online.empty()) {
+                throw std::runtime_error("cannot read online cpus from " + root.string());
+            }
+
+            std::vector<CpuInfo> cpus;
+            cpus.reserve(online.size());
+            for (const int cpu: online) {
+                const std::filesystem::path cpu_path = root / ("cpu" + std::to_string(cpu));
+                CpuInfo info;
+                info.cpu = cpu;
+                info.package_id = read_int(cpu_path / "topology" / "physical_package_id", 0);
+                // core_id is only unique within a package
+                info.core_id = (info.package_id << 16) | read_int(cpu_path / "topology" / "core_id", cpu);
+                info.numa_node = find_numa_node(cpu_path);
+                read_caches(cpu_path, info);
+                cpus.push_back(info);
+            }
+            return CpuTopology(std::move(cpus));
+        }
+
+        // "0-3,8,10-11" -> {0, 1, 2, 3, 8, 10, 11}
+        static std::vector<int> parse_cpu_list(const std::string &list) {
+            std::vector<int> result;
+            std::stringstream stream(list);
+            std::string range;
+            while (std::getline(stream, range, ',')) {
+                range.erase(std::remove_if(range.begin(), range.end(), ::isspace), range.end());
+                if (range.empty()) {
+                    continue;
+                }
+                const size_t dash = range.find('-');
+                const int first = std::stoi(range.substr(0, dash));
+                const int last = dash == std::string::npos ? first : std::stoi(range.substr(dash + 1));
+                for (int cpu = first; cpu <= last; ++cpu) {
+                    result.push_back(cpu);
+                }
+            }
+            return result;
+        }
+
+        [[nodiscard]] const std::vector<CpuInfo> &get_cpus() const {
+            return cpus;
+        }
+
+        [[nodiscard]] const CpuInfo &get_cpu(const int cpu) const {
+            for (const auto &info: cpus) {
+                if (info.cpu == cpu) {
+                    return info;
+                }
+            }
+            throw std::invalid_argument("unknown cpu " + std::to_string(cpu));
+        }
+
+        [[nodiscard]] std::vector<int> get_numa_node_cpus(const int numa_node) const {
+            std::vector<int> result;
+            for (const auto &info: cpus) {
+                if (info.numa_node == numa_node) {
+                    result.push_back(info.cpu);
+                }
+            }
+            return result;
+        }
+    };
+}
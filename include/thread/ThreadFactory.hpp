@@ -0,0 +1,96 @@
+#pragma once
+
+#include <cstring>
+#include <iostream>
+#include <optional>
+#include <stop_token>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace disruptor {
+    /**
+     * Where and how a processor or producer thread runs.
+     * cpus: allowed cores, empty lets the scheduler decide. Pin one thread per core for stable numbers.
+     * fifo_priority: SCHED_FIFO priority (1-99), requires CAP_SYS_NICE.
+     * name: visible in top/perf, truncated to 15 characters by Linux.
+     */
+    struct ThreadConfig {
+        std::vector<int> cpus;
+        std::optional<int> fifo_priority;
+        std::string name;
+    };
+
+    class ThreadFactory {
+    public:
+        /**
+         * Apply the config to the calling thread. A setting that cannot be applied (missing core, no privilege for
+         * SCHED_FIFO) only prints a warning so the pipeline still runs.
+         *
+         * @return true if every setting was applied
+         */
+        static bool apply_to_current_thread(const ThreadConfig &config) {
+            bool applied = true;
+#if defined(__linux__)
+            const pthread_t thread = pthread_self();
+
+            if (!config.name.empty()) {
+                const std::string name = config.name.substr(0, 15);
+                if (const int error = pthread_setname_np(thread, name.c_str()); error != 0) {
+                    std::cerr << "WARNING: cannot set thread name " << name << ": " << std::strerror(error) << std::endl;
+                    applied = false;
+                }
+            }
+
+            if (!config.cpus.empty()) {
+                cpu_set_t cpu_set;
+                CPU_ZERO(&cpu_set);
+                for (const int cpu: config.cpus) {
+                    CPU_SET(cpu, &cpu_set);
+                }
+                if (const int error = pthread_setaffinity_np(thread, sizeof(cpu_set), &cpu_set); error != 0) {
+                    std::cerr << "WARNING: cannot pin thread " << config.name << ": " << std::strerror(error) << std::endl;
+                    applied = false;
+                }
+            }
+
+            if (config.fifo_priority.has_value()) {
+                const sched_param param{*config.fifo_priority};
+                if (const int error = pthread_setschedparam(thread, SCHED_FIFO, &param); error != 0) {
+                    std::cerr << "WARNING: cannot set SCHED_FIFO " << *config.fifo_priority << " for thread "
+                            << config.name << ": " << std::strerror(error) << std::endl;
+                    applied = false;
+                }
+            }
+#else
+            applied = config.cpus.empty() && !config.fifo_priority.has_value() && config.name.empty();
+#endif
+            return applied;
+        }
+
+        // start a thread that applies the config before running "body"
+        template<typename Function>
+        [[nodiscard]] static std::thread create(ThreadConfig config, Function &&body) {
+            return std::thread([config = std::move(config), body = std::forward<Function>(body)]() mutable {
+                apply_to_current_thread(config);
+                body();
+            });
+        }
+
+        // same as create, "body" gets the stop token of the std::jthread, which requests the stop when destroyed
+        template<typename Function>
+        [[nodiscard]] static std::jthread create_jthread(ThreadConfig config, Function &&body) {
+            return std::jthread([config = std::move(config), body = std::forward<Function>(body)](
+                const std::stop_token &stop_token) mutable {
+                    apply_to_current_thread(config);
+                    body(stop_token);
+                });
+        }
+    };
+}
@@ -0,0 +1,245 @@
+#pragma once
+
+#include <algorithm>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <numeric>
+#include <queue>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+#include "CpuTopology.hpp"
+#include "ThreadFactory.hpp"
+#include "../sequence/Sequence.hpp"
+
+/**
+ * Assign one core per pipeline thread so that threads handing sequences to each other share a cache.
+ * The pipeline is described with the same sequences that wire the ring:
+ * - a producer by the cursor it publishes to (producers of a MultiProducerSequencer share it).
+ * - a consumer by its own cursor and the sequences passed to its ProcessingSequenceBarrier.
+ * Threads connected through these sequences form one pipeline; each pipeline is packed into the last level cache
+ * domain with the most free physical cores, in dependency order so neighbours also tend to share an L2.
+ * SMT siblings are used only once every physical core of the domain is taken.
+ */
+namespace disruptor {
+    class ThreadPlacement {
+        struct Node {
+            std::string name;
+            const Sequence *cursor;
+            std::vector<const Sequence *> dependencies;
+        };
+
+        CpuTopology topology;
+        std::vector<int> excluded_cpus;
+        std::vector<Node> nodes;
+
+        void add_node(std::string name, const Sequence &cursor, std::vector<const Sequence *> dependencies) {
+            for (const auto &node: nodes) {
+                if (node.name == name) {
+                    throw std::invalid_argument("duplicate thread name " + name);
+                }
+            }
+            nodes.push_back({std::move(name), &cursor, std::move(dependencies)});
+        }
+
+        // index of the nodes that each node waits on
+        [[nodiscard]] std::vector<std::vector<size_t> > build_upstreams() const {
+            std::unordered_map<const Sequence *, std::vector<size_t> > owners;
+            for (size_t i = 0; i < nodes.size(); ++i) {
+                owners[nodes[i].cursor].push_back(i);
+            }
+
+            std::vector<std::vector<size_t> > upstreams(nodes.size());
+            for (size_t i = 0; i < nodes.size(); ++i) {
+                for (const Sequence *dependency: nodes[i].dependencies) {
+                    if (const auto owner = owners.find(dependency); owner != owners.end()) {
+                        for (const size_t upstream: owner->second) {
+                            if (upstream != i) {
+                                upstreams[i].push_back(upstream);
+                            }
+                        }
+                    }
+                }
+            }
+            return upstreams;
+        }
+
+        // connected pipelines, each in dependency order (producers first), largest pipeline first
+        [[nodiscard]] std::vector<std::vector<size_t> > build_pipelines() const {
+            const std::vector<std::vector<size_t> > upstreams = build_upstreams();
+
+            std::vector<size_t> parent(nodes.size());
+            std::iota(parent.begin(), parent.end(), 0);
+            const std::function<size_t(size_t)> find = [&](const size_t i) {
+                return parent[i] == i ? i : parent[i] = find(parent[i]);
+            };
+            for (size_t i = 0; i < nodes.size(); ++i) {
+                for (const size_t upstream: upstreams[i]) {
+                    parent[find(i)] = find(upstream);
+                }
+            }
+
+            std::vector<std::vector<size_t> > downstreams(nodes.size());
+            std::vector<size_t> pending_upstreams(nodes.size());
+            for (size_t i = 0; i < nodes.size(); ++i) {
+                pending_upstreams[i] = upstreams[i].size();
+                for (const size_t upstream: upstreams[i]) {
+                    downstreams[upstream].push_back(i);
+                }
+            }
+
+            std::queue<size_t> ready;
+            for (size_t i = 0; i < nodes.size(); ++i) {
+                if (pending_upstreams[i] == 0) {
+                    ready.push(i);
+                }
+            }
+
+            std::map<size_t, std::vector<size_t> > pipelines;
+            std::vector<bool> placed(nodes.size(), false);
+            while (!ready.empty()) {
+                const size_t i = ready.front();
+                ready.pop();
+                pipelines[find(i)].push_back(i);
+                placed[i] = true;
+                for (const size_t downstream: downstreams[i]) {
+                    if (--pending_upstreams[downstream] == 0) {
+                        ready.push(downstream);
+                    }
+                }
+            }
+            // a dependency cycle cannot happen in a valid ring, keep such nodes anyway
+            for (size_t i = 0; i < nodes.size(); ++i) {
+                if (!placed[i]) {
+                    pipelines[find(i)].push_back(i);
+                }
+            }
+
+            std::vector<std::vector<size_t> > result;
+            for (auto &[root, pipeline]: pipelines) {
+                result.push_back(std::move(pipeline));
+            }
+            std::stable_sort(result.begin(), result.end(), [](const auto &a, const auto &b) {
+                return a.size() > b.size();
+            });
+            return result;
+        }
+
+    public:
+        explicit ThreadPlacement(CpuTopology topology) : topology(std::move(topology)) {
+        }
+
+        // keep some cores for the OS, interrupts or other processes
+        void exclude_cpus(const std::initializer_list<int> cpus) {
+            excluded_cpus.insert(excluded_cpus.end(), cpus.begin(), cpus.end());
+        }
+
+        void add_producer(std::string name, const Sequence &cursor) {
+            add_node(std::move(name), cursor, {});
+        }
+
+        void add_consumer(std::string name, const Sequence &cursor,
+                          const std::initializer_list<std::reference_wrapper<Sequence> > dependent_sequences) {
+            std::vector<const Sequence *> dependencies;
+            for (const auto &dependency: dependent_sequences) {
+                dependencies.push_back(&dependency.get());
+            }
+            add_node(std::move(name), cursor, std::move(dependencies));
+        }
+
+        /**
+         * @return a single-core ThreadConfig for every added thread, keyed by name. Start each thread with
+         * ThreadFactory::create or BatchEventProcessor::start.
+         */
+        [[nodiscard]] std::unordered_map<std::string, ThreadConfig> plan() const {
+            // free cores of every last level cache domain: one thread per physical core first, then SMT siblings
+            struct Domain {
+                int numa_node = 0;
+                std::vector<int> primary;
+                std::vector<int> secondary;
+            };
+            std::map<int, Domain> domains;
+            // every cpu that is not excluded, shared round robin once the free cores run out
+            std::vector<int> allowed_cpus;
+            std::unordered_map<int, bool> seen_cores;
+            std::vector<CpuInfo> cpus = topology.get_cpus();
+            std::sort(cpus.begin(), cpus.end(), [](const CpuInfo &a, const CpuInfo &b) {
+                return std::tie(a.llc_id, a.l2_id, a.core_id, a.cpu) < std::tie(b.llc_id, b.l2_id, b.core_id, b.cpu);
+            });
+            for (const auto &info: cpus) {
+                if (std::find(excluded_cpus.begin(), excluded_cpus.end(), info.cpu) != excluded_cpus.end()) {
+                    continue;
+                }
+                allowed_cpus.push_back(info.cpu);
+                Domain &domain = domains[info.llc_id];
+                domain.numa_node = info.numa_node;
+                if (seen_cores[info.core_id]) {
+                    domain.secondary.push_back(info.cpu);
+                } else {
+                    seen_cores[info.core_id] = true;
+                    domain.primary.push_back(info.cpu);
+                }
+            }
+
+            if (allowed_cpus.empty()) {
+                throw std::invalid_argument("topology has no cpu left once the excluded cpus are removed");
+            }
+
+            const auto take_from = [](Domain &domain) {
+                std::vector<int> &pool = domain.primary.empty() ? domain.secondary : domain.primary;
+                const int cpu = pool.front();
+                pool.erase(pool.begin());
+                return cpu;
+            };
+
+            std::unordered_map<std::string, ThreadConfig> result;
+            size_t overflow = 0;
+
+            for (const auto &pipeline: build_pipelines()) {
+                // the domain with the most free physical cores hosts the pipeline
+                int home = -1;
+                std::pair<size_t, size_t> best_free{0, 0};
+                for (const auto &[llc_id, domain]: domains) {
+                    const std::pair free{domain.primary.size(), domain.secondary.size()};
+                    if (home == -1 || free > best_free) {
+                        home = llc_id;
+                        best_free = free;
+                    }
+                }
+
+                for (const size_t i: pipeline) {
+                    // home domain (physical cores, then SMT siblings), then the same NUMA node, then anywhere
+                    int cpu = -1;
+                    if (home != -1 && (!domains[home].primary.empty() || !domains[home].secondary.empty())) {
+                        cpu = take_from(domains[home]);
+                    }
+                    const int home_node = home == -1 ? 0 : domains[home].numa_node;
+                    for (int pass = 0; pass < 2 && cpu == -1; ++pass) {
+                        for (auto &[llc_id, domain]: domains) {
+                            const bool has_free = !domain.primary.empty() || !domain.secondary.empty();
+                            if (has_free && (pass == 1 || domain.numa_node == home_node)) {
+                                cpu = take_from(domain);
+                                break;
+                            }
+                        }
+                    }
+
+                    if (cpu == -1) {
+                        // more threads than cores: share the allowed cores round robin, never an excluded one
+                        cpu = allowed_cpus[overflow++ % allowed_cpus.size()];
+                        std::cerr << "WARNING: not enough cores, thread " << nodes[i].name << " shares cpu " << cpu
+                                << std::endl;
+                    }
+
+                    result[nodes[i].name] = ThreadConfig{{cpu}, std::nullopt, nodes[i].name};
+                }
+            }
+
+            return result;
+        }
+    };
+}
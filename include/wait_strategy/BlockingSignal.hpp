@@ -0,0 +1,106 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <climits>
+#include <cstdint>
+#include <thread>
+
+#if defined(__linux__)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <ctime>
+#endif
+
+#include "../common/Common.hpp"
+
+/**
+ * Parking lot shared between a sequencer and the consumers that block on it.
+ * epoch: futex word, bumped by the producer every time it wakes the sleeping consumers.
+ * waiters: number of consumers currently parked (or about to park). The producer only pays for the wake syscall
+ * when this is not zero, so the publish fast path is a fence and a load of a cache line that is almost never written.
+ * The fence pairs with the waiter registration: either the consumer sees the publish before it parks, or the producer
+ * sees the waiter and wakes it.
+ */
+namespace disruptor {
+    class BlockingSignal final {
+        alignas(CACHE_LINE_SIZE) const char padding_1[CACHE_LINE_SIZE] = {};
+        std::atomic<uint32_t> epoch{0};
+        std::atomic<uint32_t> waiters{0};
+        const char padding_2[CACHE_LINE_SIZE - sizeof(std::atomic<uint32_t>) * 2] = {};
+        const char padding_3[CACHE_LINE_SIZE] = {};
+
+        void futex_wait(const uint32_t observed_epoch, const std::chrono::nanoseconds timeout) {
+#if defined(__linux__)
+            const auto seconds = std::chrono::duration_cast<std::chrono::seconds>(timeout);
+            const timespec relative_timeout{
+                static_cast<time_t>(seconds.count()),
+                static_cast<long>((timeout - seconds).count())
+            };
+            // EAGAIN (epoch already moved), EINTR and ETIMEDOUT all mean "go and re-check the sequence"
+            syscall(SYS_futex, reinterpret_cast<uint32_t *>(&epoch), FUTEX_WAIT_PRIVATE, observed_epoch,
+                    &relative_timeout, nullptr, 0);
+#else
+            const auto deadline = std::chrono::steady_clock::now() + timeout;
+            while (epoch.load(std::memory_order_acquire) == observed_epoch
+                   && std::chrono::steady_clock::now() < deadline) {
+                std::this_thread::yield();
+            }
+#endif
+        }
+
+        void futex_wake_all() {
+#if defined(__linux__)
+            syscall(SYS_futex, reinterpret_cast<uint32_t *>(&epoch), FUTEX_WAKE_PRIVATE, INT_MAX, nullptr, nullptr, 0);
+#endif
+        }
+
+    public:
+        BlockingSignal() = default;
+
+        BlockingSignal(const BlockingSignal &) = delete;
+
+        BlockingSignal &operator=(const BlockingSignal &) = delete;
+
+        /**
+         * Park the calling thread until it is signalled or the timeout expires, unless "ready" already holds once
+         * this thread has registered itself as a waiter (re-checking after registration closes the lost wake-up window).
+         * Only producers signal: "ready" must hold once the producer publishes, not when another processor moves.
+         */
+        template<typename Condition>
+        void park_unless(Condition &&ready, const std::chrono::nanoseconds timeout) {
+            waiters.fetch_add(1, std::memory_order_seq_cst);
+            const uint32_t observed_epoch = epoch.load(std::memory_order_seq_cst);
+
+            if (!ready()) {
+                futex_wait(observed_epoch, timeout);
+            }
+
+            waiters.fetch_sub(1, std::memory_order_release);
+        }
+
+        // called by the producer after every publish
+        [[gnu::hot]] void signal_when_blocking() {
+            // StoreLoad: the publish must be visible before "waiters" is read, see park_unless
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (waiters.load(std::memory_order_relaxed) != 0) [[unlikely]] {
+                signal_all();
+            }
+        }
+
+        void signal_all() {
+            epoch.fetch_add(1, std::memory_order_release);
+            futex_wake_all();
+        }
+
+        [[nodiscard]] uint32_t get_waiters() const {
+            return waiters.load(std::memory_order_acquire);
+        }
+
+        // bumped once per signal_all(), i.e. per wake syscall
+        [[nodiscard]] uint32_t get_epoch() const {
+            return epoch.load(std::memory_order_acquire);
+        }
+    };
+}
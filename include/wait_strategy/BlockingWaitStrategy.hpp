@@ -0,0 +1,84 @@
+#pragma once
+
+#include <string>
+#include <chrono>
+#include <thread>
+#include "WaitStrategy.hpp"
+#include "BlockingSignal.hpp"
+#include "../barriers/SequenceBarrier.hpp"
+#include "../sequencer/Sequencer.hpp"
+#include "Util.hpp"
+
+/**
+ * Spin for a short while, then park the consumer on the sequencer's futex until a producer publishes.
+ * Suited to low-traffic rings where idle consumers should not burn a core.
+ * Only the producers signal, so a consumer parks only while the sequence is unpublished. Once it is published and
+ * the consumer is behind another processor, it yields until that processor catches up (as the Java strategy spins).
+ */
+namespace disruptor {
+    template<size_t NUMBER_DEPENDENT_SEQUENCES>
+    class BlockingWaitStrategy final : public WaitStrategy<NUMBER_DEPENDENT_SEQUENCES> {
+        static constexpr int SPIN_TRIES = 100;
+
+        Sequencer &sequencer;
+        BlockingSignal &signal;
+        // no wake-up is lost, the timeout only bounds a park in case of a bug in a publish path
+        std::chrono::nanoseconds park_timeout;
+
+    public:
+        static constexpr std::chrono::nanoseconds DEFAULT_PARK_TIMEOUT = std::chrono::seconds(1);
+
+        explicit BlockingWaitStrategy(Sequencer &sequencer,
+                                      const std::chrono::nanoseconds park_timeout = DEFAULT_PARK_TIMEOUT)
+            : sequencer(sequencer), signal(sequencer.get_blocking_signal()), park_timeout(park_timeout) {
+        }
+
+        [[nodiscard]] size_t wait_for(const size_t sequence,
+                                      SequenceGroupForSingleThread<NUMBER_DEPENDENT_SEQUENCES> &dependent_sequences,
+                                      const SequenceBarrier &barrier,
+                                      const Deadline deadline) override {
+            size_t available_sequence;
+            int spin_counter = 0;
+
+            while ((available_sequence = dependent_sequences.get()) < sequence) {
+                // alerted or expired: give up with what is available, the barrier tells which one happened
+                if (barrier.is_alerted() || Util::is_expired(deadline)) [[unlikely]] {
+                    return available_sequence;
+                }
+
+                if (spin_counter < SPIN_TRIES) [[likely]] {
+                    Util::cpu_pause();
+                    spin_counter++;
+                    continue;
+                }
+
+                if (sequencer.is_available(sequence)) {
+                    // published, only a dependent processor is behind and it never signals
+                    std::this_thread::yield();
+                    continue;
+                }
+
+                // never sleep past the deadline
+                signal.park_unless([&] {
+                    return barrier.is_alerted() || dependent_sequences.get() >= sequence
+                           || sequencer.is_available(sequence);
+                }, Util::time_until(deadline, park_timeout));
+            }
+
+            return available_sequence;
+        }
+
+        // only call from the processor thread, or before it starts
+        void set_park_timeout(const std::chrono::nanoseconds timeout) {
+            park_timeout = timeout;
+        }
+
+        void signal_all_when_blocking() override {
+            signal.signal_all();
+        }
+
+        [[nodiscard]] std::string to_string() const noexcept override {
+            return "BlockingWaitStrategy";
+        }
+    };
+}
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <string>
+#include <thread>
+#include "WaitStrategy.hpp"
+#include "BlockingSignal.hpp"
+#include "../barriers/SequenceBarrier.hpp"
+#include "../common/BackoffPolicy.hpp"
+#include "../sequencer/Sequencer.hpp"
+#include "Util.hpp"
+
+/**
+ * Spin, then yield, then park, with the budget of each phase taken from the barrier's BackoffPolicy.
+ * With ParkMode::BLOCK the park phase hands off to the sequencer's BlockingSignal instead of sleeping.
+ */
+namespace disruptor {
+    template<size_t NUMBER_DEPENDENT_SEQUENCES>
+    class PhasedBackoffWaitStrategy final : public WaitStrategy<NUMBER_DEPENDENT_SEQUENCES> {
+        BackoffPolicy policy;
+        Sequencer &sequencer;
+        BlockingSignal &signal;
+
+    public:
+        PhasedBackoffWaitStrategy(const BackoffPolicy &policy, Sequencer &sequencer)
+            : policy(policy), sequencer(sequencer), signal(sequencer.get_blocking_signal()) {
+        }
+
+        [[nodiscard]] size_t wait_for(const size_t sequence,
+                                      SequenceGroupForSingleThread<NUMBER_DEPENDENT_SEQUENCES> &dependent_sequences,
+                                      const SequenceBarrier &barrier,
+                                      const Deadline deadline) override {
+            size_t available_sequence;
+            int wait_counter = 0;
+
+            while ((available_sequence = dependent_sequences.get()) < sequence) {
+                // alerted or expired: give up with what is available, the barrier tells which one happened
+                if (barrier.is_alerted() || Util::is_expired(deadline)) [[unlikely]] {
+                    return available_sequence;
+                }
+
+                if (policy.park_mode == ParkMode::BLOCK
+                    && wait_counter >= policy.spin_tries + policy.yield_tries) [[unlikely]] {
+                    // as in BlockingWaitStrategy, only an unpublished sequence is worth parking for
+                    if (sequencer.is_available(sequence)) {
+                        std::this_thread::yield();
+                    } else {
+                        signal.park_unless([&] {
+                            return barrier.is_alerted() || dependent_sequences.get() >= sequence
+                                   || sequencer.is_available(sequence);
+                        }, Util::time_until(deadline, policy.park_duration));
+                    }
+                    continue;
+                }
+
+                Util::adaptive_wait(wait_counter, policy);
+            }
+
+            return available_sequence;
+        }
+
+        // only call from the processor thread, or before it starts
+        void set_backoff_policy(const BackoffPolicy &backoff_policy) {
+            policy = backoff_policy;
+        }
+
+        [[nodiscard]] const BackoffPolicy &get_backoff_policy() const {
+            return policy;
+        }
+
+        void signal_all_when_blocking() override {
+            if (policy.park_mode == ParkMode::BLOCK) {
+                signal.signal_all();
+            }
+        }
+
+        [[nodiscard]] std::string to_string() const noexcept override {
+            return "PhasedBackoffWaitStrategy";
+        }
+    };
+}
@@ -0,0 +1,107 @@
+#pragma once
+
+#include <string>
+#include <algorithm>
+#include <chrono>
+#include "WaitStrategy.hpp"
+#include "../barriers/SequenceBarrier.hpp"
+#include "../common/BackoffPolicy.hpp"
+#include "Util.hpp"
+
+/**
+ * AdaptiveWaitStrategy whose spin/yield budget follows the observed gap between events.
+ * Every wait that has to back off is timed and folded into a moving average:
+ * - short gaps (events arrive within SPIN_WINDOW): spin long enough to cover ~2x the average gap, no context switch.
+ * - medium gaps (up to YIELD_WINDOW): minimal spin, keep the yield phase.
+ * - long gaps: minimal spin and yield, park almost immediately.
+ * The fast path (sequence already available) never reads the clock.
+ */
+namespace disruptor {
+    template<size_t NUMBER_DEPENDENT_SEQUENCES>
+    class SelfTuningWaitStrategy final : public WaitStrategy<NUMBER_DEPENDENT_SEQUENCES> {
+        static constexpr int MIN_SPIN_TRIES = 10;
+        static constexpr int MAX_SPIN_TRIES = 1'000'000;
+        static constexpr int MIN_YIELD_TRIES = 1;
+        static constexpr int DEFAULT_YIELD_TRIES = 10;
+        static constexpr auto SPIN_WINDOW = std::chrono::microseconds(20);
+        static constexpr auto YIELD_WINDOW = std::chrono::microseconds(200);
+        static constexpr int EWMA_SHIFT = 3; // new samples weigh 1/8
+
+        BackoffPolicy policy;
+        int64_t average_wait_ns;
+        int64_t spin_cost_ns = 40; // refined from waits that ended during the spin phase
+
+        void retune() {
+            if (average_wait_ns <= std::chrono::nanoseconds(SPIN_WINDOW).count()) {
+                policy.spin_tries = static_cast<int>(std::clamp<int64_t>(
+                    average_wait_ns * 2 / spin_cost_ns, MIN_SPIN_TRIES, MAX_SPIN_TRIES));
+                policy.yield_tries = DEFAULT_YIELD_TRIES;
+            } else if (average_wait_ns <= std::chrono::nanoseconds(YIELD_WINDOW).count()) {
+                policy.spin_tries = MIN_SPIN_TRIES;
+                policy.yield_tries = DEFAULT_YIELD_TRIES;
+            } else {
+                policy.spin_tries = MIN_SPIN_TRIES;
+                policy.yield_tries = MIN_YIELD_TRIES;
+            }
+        }
+
+    public:
+        explicit SelfTuningWaitStrategy(const BackoffPolicy &initial_policy)
+            : policy(initial_policy),
+              average_wait_ns(std::chrono::nanoseconds(SPIN_WINDOW).count() / 2) {
+        }
+
+        [[nodiscard]] size_t wait_for(const size_t sequence,
+                                      SequenceGroupForSingleThread<NUMBER_DEPENDENT_SEQUENCES> &dependent_sequences,
+                                      const SequenceBarrier &barrier,
+                                      const Deadline deadline) override {
+            size_t available_sequence = dependent_sequences.get();
+            if (available_sequence >= sequence) [[likely]] {
+                return available_sequence;
+            }
+
+            const auto start = std::chrono::steady_clock::now();
+            int wait_counter = 0;
+            int spins = 0;
+
+            do {
+                // alerted or expired: give up with what is available, the barrier tells which one happened
+                if (barrier.is_alerted() || Util::is_expired(deadline)) [[unlikely]] {
+                    return available_sequence;
+                }
+                spins += wait_counter < policy.spin_tries;
+                Util::adaptive_wait(wait_counter, policy);
+            } while ((available_sequence = dependent_sequences.get()) < sequence);
+
+            const auto waited = std::chrono::steady_clock::now() - start;
+            if (wait_counter < policy.spin_tries && spins > 0) {
+                // the wait ended while spinning, so it tells us what one spin costs on this core
+                const int64_t observed_spin_cost = std::max<int64_t>(
+                    1, std::chrono::duration_cast<std::chrono::nanoseconds>(waited).count() / spins);
+                spin_cost_ns += (observed_spin_cost - spin_cost_ns) >> EWMA_SHIFT;
+                spin_cost_ns = std::max<int64_t>(1, spin_cost_ns);
+            }
+            observe(std::chrono::duration_cast<std::chrono::nanoseconds>(waited));
+
+            return available_sequence;
+        }
+
+        // fold one measured wait into the moving average and recompute the budget
+        void observe(const std::chrono::nanoseconds wait_duration) {
+            average_wait_ns += (wait_duration.count() - average_wait_ns) >> EWMA_SHIFT;
+            retune();
+        }
+
+        [[nodiscard]] const BackoffPolicy &get_backoff_policy() const {
+            return policy;
+        }
+
+        [[nodiscard]] std::chrono::nanoseconds get_average_wait() const {
+            return std::chrono::nanoseconds(average_wait_ns);
+        }
+
+        [[nodiscard]] std::string to_string() const noexcept override {
+            return "SelfTuningWaitStrategy";
+        }
+    };
+}
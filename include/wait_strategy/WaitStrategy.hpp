@@ -2,6 +2,7 @@
 
 #include "../barriers/SequenceBarrier.hpp"
 #include "../sequence/SequenceGroupForSingleThread.hpp"
+#include "../common/Common.hpp"
 
 namespace disruptor
 {
@@ -24,14 +25,22 @@ namespace disruptor
          * @param sequence          to be waited on.
          * @param dependent_sequences            the main or dependent sequences
          * @param barrier           the processor is waiting on.
-         * @return the sequence that is available which may be greater than the requested sequence.
-         * @throws AlertException if the status of the Disruptor has changed.
-         * @throws TimeoutException if a timeout occurs before waiting completes (not used by some strategies)
+         * @param deadline          give up waiting after this point in time, NO_DEADLINE to wait forever.
+         * @return the sequence that is available which may be greater than the requested sequence, or less than the
+         * requested sequence if the barrier was alerted or the deadline passed (the barrier tells which one).
          */
         [[nodiscard]] virtual size_t wait_for(
             size_t sequence,
             SequenceGroupForSingleThread<NUMBER_DEPENDENT_SEQUENCES> &dependent_sequences,
-            const SequenceBarrier &barrier) = 0;
+            const SequenceBarrier &barrier,
+            Deadline deadline) = 0;
+
+        /**
+         * Wake up every consumer parked by this strategy, e.g. when the barrier is alerted.
+         * Strategies that never park have nothing to do.
+         */
+        virtual void signal_all_when_blocking() {
+        }
 
         /**
          * String representation of the wait strategy
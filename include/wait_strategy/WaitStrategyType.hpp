@@ -4,4 +4,7 @@ enum class WaitStrategyType
 {
     ADAPTIVE,
     YIELD,
+    BLOCKING,
+    PHASED_BACKOFF,
+    SELF_TUNING,
 };
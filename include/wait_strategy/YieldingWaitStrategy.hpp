@@ -11,11 +11,15 @@ namespace disruptor {
     public:
         [[nodiscard]] size_t wait_for(const size_t sequence,
                                       SequenceGroupForSingleThread<NUMBER_DEPENDENT_SEQUENCES> &dependent_sequences,
-                                      const SequenceBarrier &barrier) override {
+                                      const SequenceBarrier &barrier,
+                                      const Deadline deadline) override {
             size_t available_sequence;
 
             while ((available_sequence = dependent_sequences.get()) < sequence) {
-                barrier.check_alert();
+                // alerted or expired: give up with what is available, the barrier tells which one happened
+                if (barrier.is_alerted() || Util::is_expired(deadline)) [[unlikely]] {
+                    return available_sequence;
+                }
                 std::this_thread::yield();
             }
 
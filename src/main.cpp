@@ -1,5 +1,10 @@
 #include <iomanip>
 #include <iostream>
+#include <algorithm>
+#include <vector>
+#include <utility>
+#include <functional>
+#include <type_traits>
 
 #include "../include/processor/BatchEventProcessor.hpp"
 #include "event.hpp"
@@ -9,7 +14,10 @@
 #include "../include/sequencer/SingleProducerSequencer.hpp"
 #include "../include/sequence/Sequence.hpp"
 #include "../include/common/Util.hpp"
+#include "../include/common/Simd.hpp"
+#include "../include/sequence/SequenceGroupForMultiThread.hpp"
 #include "../include/wait_strategy/WaitStrategyType.hpp"
+#include "../include/thread/ThreadFactory.hpp"
 
 
 void run_single_sequencer() {
@@ -135,6 +143,9 @@ void run_multiple_sequencer() {
 }
 
 
+// INLINE_HANDLER: the processor is templated on the lambda type instead of std::function, so the handler is inlined
+// STATIC_PIPELINE: the processor and the barrier are templated on the concrete barrier and sequencer, no virtual call
+template<bool INLINE_HANDLER = false, bool STATIC_PIPELINE = false>
 void test_1_producer_1_consumer() {
     constexpr size_t ring_buffer_size = 1024;
     disruptor::RingBuffer<disruptor::Event, ring_buffer_size> ring_buffer([]() { return disruptor::Event(); });
@@ -148,14 +159,21 @@ void test_1_producer_1_consumer() {
     auto eventHandler_1 = [&counter](disruptor::Event &event, size_t sequence, bool endOfBatch) {
         counter++;
     };
+    using EventHandler = std::conditional_t<INLINE_HANDLER, decltype(eventHandler_1),
+        std::function<void(disruptor::Event &, size_t, bool)> >;
     constexpr size_t NUMBER_DEPENDENT_SEQUENCES = 1;
-    disruptor::ProcessingSequenceBarrier<WaitStrategyType::ADAPTIVE, NUMBER_DEPENDENT_SEQUENCES> sequence_barrier_1(
-        true, {cursor_sequencer}, sequencer);
-    disruptor::BatchEventProcessor<disruptor::Event, ring_buffer_size> processor_1(
+    using Sequencer = std::conditional_t<STATIC_PIPELINE, decltype(sequencer), disruptor::Sequencer>;
+    using Barrier = disruptor::ProcessingSequenceBarrier<WaitStrategyType::ADAPTIVE, NUMBER_DEPENDENT_SEQUENCES,
+        Sequencer>;
+    Barrier sequence_barrier_1(true, {cursor_sequencer}, sequencer);
+    disruptor::BatchEventProcessor<disruptor::Event, ring_buffer_size, EventHandler,
+        std::conditional_t<STATIC_PIPELINE, Barrier, disruptor::SequenceBarrier> > processor_1(
         sequence_barrier_1, eventHandler_1, ring_buffer);
     std::reference_wrapper<disruptor::Sequence> cursor_batch_event_processor_1 = processor_1.get_cursor();
     sequencer.add_gating_sequences({cursor_batch_event_processor_1});
-    std::thread processorThread_1([&processor_1]() { processor_1.run(); });
+    // gắn consumer vào core 1, producer (thread hiện tại) vào core 0
+    std::thread processorThread_1 = processor_1.start({{1}, std::nullopt, "consumer-1"});
+    disruptor::ThreadFactory::apply_to_current_thread({{0}, std::nullopt, "producer"});
 
     // Số lượng sự kiện sẽ được gửi
     constexpr size_t NUM_EVENTS = 10'000'000'004;
@@ -382,8 +400,11 @@ void test_3_producer_1_consumer() {
     std::cout << "NUM_PRODUCER: " << NUM_PRODUCER << std::endl;
     std::cout << "NUM_EVENTS: " << NUM_EVENTS << std::endl;
 
-    disruptor::RingBuffer<disruptor::Event, BUFFER_SIZE> ring_buffer([]() { return disruptor::Event(); });
-    disruptor::MultiProducerSequencer<disruptor::Event, BUFFER_SIZE, NUMBER_GATING_SEQUENCES> sequencer(ring_buffer);
+    // 32K slots: entries and availability flags are mapped on huge pages instead of the stack, faulted in up front
+    disruptor::RingBuffer<disruptor::Event, disruptor::DYNAMIC_SIZE> ring_buffer(
+        BUFFER_SIZE, []() { return disruptor::Event(); });
+    disruptor::MultiProducerSequencer<disruptor::Event, disruptor::DYNAMIC_SIZE, NUMBER_GATING_SEQUENCES> sequencer(
+        ring_buffer);
     std::reference_wrapper<disruptor::Sequence> cursor_sequencer = sequencer.get_cursor();
 
 
@@ -394,7 +415,7 @@ void test_3_producer_1_consumer() {
     };
     disruptor::ProcessingSequenceBarrier<WaitStrategyType::ADAPTIVE, NUMBER_DEPENDENT_SEQUENCES> sequence_barrier_1(
         true, {cursor_sequencer}, sequencer);
-    disruptor::BatchEventProcessor<disruptor::Event, BUFFER_SIZE> processor_1(
+    disruptor::BatchEventProcessor<disruptor::Event, disruptor::DYNAMIC_SIZE> processor_1(
         sequence_barrier_1, eventHandler_1, ring_buffer);
     std::reference_wrapper<disruptor::Sequence> cursor_batch_event_processor_1 = processor_1.get_cursor();
     std::thread processorThread_1([&processor_1]() { processor_1.run(); });
@@ -448,6 +469,101 @@ void test_3_producer_1_consumer() {
 }
 
 
+void print_park_distribution(const std::string &name, std::vector<int64_t> &samples_ns) {
+    std::sort(samples_ns.begin(), samples_ns.end());
+    const auto percentile = [&samples_ns](const double p) {
+        return samples_ns[std::min(samples_ns.size() - 1, static_cast<size_t>(p * samples_ns.size()))];
+    };
+    std::cout << std::left << std::setw(36) << name
+            << " p50: " << std::setw(8) << percentile(0.50)
+            << " p90: " << std::setw(8) << percentile(0.90)
+            << " p99: " << std::setw(8) << percentile(0.99)
+            << " p99.9: " << std::setw(8) << percentile(0.999)
+            << " max: " << samples_ns.back() << " (ns)" << std::endl;
+}
+
+
+// đo thời gian thực tế của 1 lần park (từ lúc gọi đến lúc thread chạy lại)
+void test_park_latency() {
+    constexpr size_t NUM_SAMPLES = 20'000;
+    std::vector<int64_t> samples_ns(NUM_SAMPLES);
+
+    const auto measure = [&samples_ns](const std::string &name, auto &&park) {
+        for (auto &sample: samples_ns) {
+            const auto start = std::chrono::steady_clock::now();
+            park();
+            sample = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+        }
+        print_park_distribution(name, samples_ns);
+    };
+
+    measure("sleep_for(1ns), default slack", [] {
+        std::this_thread::sleep_for(std::chrono::nanoseconds(1));
+    });
+
+    for (const auto duration: {std::chrono::nanoseconds(1), std::chrono::nanoseconds(1'000), std::chrono::nanoseconds(10'000)}) {
+        for (const auto slack: {std::chrono::nanoseconds(1), std::chrono::nanoseconds(1'000)}) {
+            measure(std::format("precise_park({}ns), slack {}ns", duration.count(), slack.count()), [duration, slack] {
+                disruptor::Util::precise_park(duration, slack);
+            });
+        }
+    }
+
+    // khôi phục timer slack mặc định của Linux (50us)
+    disruptor::Util::set_thread_timer_slack(std::chrono::microseconds(50));
+}
+
+
+// so sánh min scalar (đọc từng Sequence) với SequenceGroupForMultiThread::get (gather SIMD) theo số lượng sequence
+template<size_t N>
+void benchmark_gating_min() {
+    constexpr size_t NUM_ITERATIONS = 10'000'000;
+    std::vector<disruptor::Sequence> sequences(N);
+    std::vector<disruptor::Sequence *> pointers;
+    for (size_t i = 0; i < N; ++i) {
+        sequences[i].set(1'000 + (i * 7) % N);
+        pointers.push_back(&sequences[i]);
+    }
+
+    disruptor::SequenceGroupForMultiThread<N> group;
+    std::vector<std::reference_wrapper<disruptor::Sequence> > references(sequences.begin(), sequences.end());
+    [&group, &references]<size_t... I>(std::index_sequence<I...>) {
+        group.set_sequences({references[I]...});
+    }(std::make_index_sequence<N>());
+
+    size_t sink = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < NUM_ITERATIONS; ++i) {
+        size_t minimum = SIZE_MAX;
+        for (const auto *sequence: pointers) {
+            minimum = std::min(minimum, sequence->get_with_acquire());
+        }
+        sink += minimum;
+    }
+    const auto scalar_ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+
+    start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < NUM_ITERATIONS; ++i) {
+        sink += group.get();
+    }
+    const auto simd_ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << std::left << "N = " << std::setw(4) << N
+            << " scalar: " << std::setw(8) << scalar_ns / NUM_ITERATIONS
+            << " " << disruptor::Simd::INSTRUCTION_SET << ": " << std::setw(8) << simd_ns / NUM_ITERATIONS
+            << " (ns/call, sink " << sink % 10 << ")" << std::endl;
+}
+
+
+void test_gating_min() {
+    benchmark_gating_min<4>();
+    benchmark_gating_min<8>();
+    benchmark_gating_min<16>();
+    benchmark_gating_min<32>();
+    benchmark_gating_min<64>();
+}
+
+
 void test_atomic() {
     constexpr uint64_t NUM_ITERATIONS = 500'000'000; // 1 tỷ
     std::atomic<uint64_t> counter{0};
@@ -538,10 +654,14 @@ int main() {
 
 
     // run_single_sequencer();
+    // test_1_producer_1_consumer<true>();
+    // test_1_producer_1_consumer<true, true>();
     // test_3_producer_1_consumer();
     test_1_producer_6_consumer();
     // test_atomic();
     // test_custom_atomic();
+    // test_park_latency();
+    // test_gating_min();
 
     return 0;
 }
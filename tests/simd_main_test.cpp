@@ -0,0 +1,22 @@
+#include <gtest/gtest.h>
+#include <iostream>
+
+#include "common/Simd.hpp"
+
+// main của các target build lại với -mavx2 / -mavx512f: bỏ qua khi CPU không hỗ trợ tập lệnh đó
+int main(int argc, char **argv) {
+#if defined(__AVX512F__)
+    if (!__builtin_cpu_supports("avx512f")) {
+        std::cout << "SKIPPED: this cpu has no AVX-512" << std::endl;
+        return 0;
+    }
+#elif defined(__AVX2__)
+    if (!__builtin_cpu_supports("avx2")) {
+        std::cout << "SKIPPED: this cpu has no AVX2" << std::endl;
+        return 0;
+    }
+#endif
+    std::cout << "Simd instruction set: " << disruptor::Simd::INSTRUCTION_SET << std::endl;
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
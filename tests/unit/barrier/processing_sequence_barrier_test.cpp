@@ -6,6 +6,7 @@
 #include "Sequencer.hpp"
 #include "Sequence.hpp"
 #include "WaitStrategyType.hpp"
+#include "TimeoutException.hpp"
 #include <future>
 #include <chrono>
 
@@ -21,6 +22,7 @@ public:
     MOCK_METHOD(bool, is_available, (size_t sequence), (const, override));
     MOCK_METHOD(size_t, get_highest_published_sequence, (size_t lo_bound, size_t hi_bound), (const, override));
     MOCK_METHOD(void, add_gating_sequences, (std::initializer_list<std::reference_wrapper<disruptor::Sequence>>), (override));
+    MOCK_METHOD(BlockingSignal &, get_blocking_signal, (), (override));
 };
 
 class ProcessingSequenceBarrierTest : public Test {
@@ -195,3 +197,55 @@ TEST_F(ProcessingSequenceBarrierTest, MultipleProcessorUpdates) {
     // Kết quả phải là giá trị nhỏ nhất trong các dependent sequence
     EXPECT_EQ(result, 100); // min(12, 10) = 10
 }
+
+// Test deadline: ném TimeoutException khi không có sự kiện trước deadline
+TEST_F(ProcessingSequenceBarrierTest, TimeoutWhenNoEventBeforeDeadline) {
+    processor1_cursor.set_with_release(5);
+
+    ProcessingSequenceBarrier<WaitStrategyType::ADAPTIVE, 1> barrier(
+        false, {std::ref(processor1_cursor)}, *sequencer);
+
+    const auto start = std::chrono::steady_clock::now();
+    EXPECT_THROW(static_cast<void>(barrier.wait_for(10, start + std::chrono::milliseconds(50))), TimeoutException);
+    EXPECT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(50));
+}
+
+// Test deadline: trả về bình thường nếu sự kiện đến trước deadline
+TEST_F(ProcessingSequenceBarrierTest, ReturnBeforeDeadlineWhenEventArrives) {
+    processor1_cursor.set_with_release(5);
+
+    ProcessingSequenceBarrier<WaitStrategyType::YIELD, 1> barrier(
+        false, {std::ref(processor1_cursor)}, *sequencer);
+
+    std::thread update_thread([this]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        this->processor1_cursor.set_with_release(12);
+    });
+
+    const size_t result = barrier.wait_for(10, std::chrono::steady_clock::now() + std::chrono::seconds(5));
+    update_thread.join();
+    EXPECT_EQ(result, 12);
+}
+
+// Test try_wait_for: alert và deadline được trả về qua WaitStatus, không ném exception
+TEST_F(ProcessingSequenceBarrierTest, TryWaitForReturnsStatusInsteadOfThrowing) {
+    processor1_cursor.set_with_release(5);
+
+    ProcessingSequenceBarrier<WaitStrategyType::ADAPTIVE, 1> barrier(
+        false, {std::ref(processor1_cursor)}, *sequencer);
+
+    WaitResult result = barrier.try_wait_for(
+        10, std::chrono::steady_clock::now() + std::chrono::milliseconds(20));
+    EXPECT_EQ(result.status, WaitStatus::TIMEOUT);
+    EXPECT_EQ(result.available_sequence, 5);
+
+    processor1_cursor.set_with_release(12);
+    result = barrier.try_wait_for(10, NO_DEADLINE);
+    EXPECT_EQ(result.status, WaitStatus::AVAILABLE);
+    EXPECT_EQ(result.available_sequence, 12);
+
+    barrier.alert();
+    result = barrier.try_wait_for(20, NO_DEADLINE);
+    EXPECT_EQ(result.status, WaitStatus::ALERTED);
+    EXPECT_LT(result.available_sequence, 20);
+}
@@ -0,0 +1,58 @@
+#include <gtest/gtest.h>
+#include <vector>
+
+#include "common/Simd.hpp"
+
+TEST(SimdTest, ShouldReturnCountWhenAllWordsMatch) {
+    for (size_t count = 0; count <= 40; ++count) {
+        const std::vector<uint32_t> words(count, 7);
+        ASSERT_EQ(disruptor::Simd::find_first_not_equal(words.data(), count, 7), count);
+    }
+}
+
+TEST(SimdTest, ShouldFindFirstMismatchInEveryLane) {
+    constexpr size_t count = 37;
+    for (size_t mismatch = 0; mismatch < count; ++mismatch) {
+        std::vector<uint32_t> words(count + 1, 3);
+        words[mismatch] = 2;
+        words[count - 1] = 4;
+        // unaligned start as the scan starts at any slot of the ring
+        ASSERT_EQ(disruptor::Simd::find_first_not_equal(words.data() + 1, count, 3),
+                  mismatch == 0 ? count - 2 : std::min(mismatch - 1, count - 2));
+    }
+}
+
+TEST(SimdTest, ShouldCompareFullWidthWords) {
+    const std::vector<uint32_t> words{UINT32_MAX, UINT32_MAX, UINT32_MAX, 0x7FFFFFFF};
+    ASSERT_EQ(disruptor::Simd::find_first_not_equal(words.data(), words.size(), UINT32_MAX), 3);
+}
+
+TEST(SimdTest, ShouldFindMinimumOfPointedValues) {
+    for (size_t count = 1; count <= 70; ++count) {
+        for (size_t position = 0; position < count; ++position) {
+            std::vector<size_t> storage(count);
+            std::vector<const size_t *> values(count);
+            for (size_t i = 0; i < count; ++i) {
+                storage[i] = 1000 + i * 7 % 13;
+                values[i] = &storage[i];
+            }
+            storage[position] = 5;
+
+            size_t index = SIZE_MAX;
+            ASSERT_EQ(disruptor::Simd::min_of_pointed(values.data(), count, index), 5);
+            ASSERT_EQ(index, position);
+        }
+    }
+}
+
+TEST(SimdTest, ShouldReportFirstMinimumOnTiesAndCompareUnsigned) {
+    std::vector<size_t> storage{9, 1ULL << 63, 4, 8, 4, 6, 4, 7, 4, 9};
+    std::vector<const size_t *> values;
+    for (const size_t &value: storage) {
+        values.push_back(&value);
+    }
+
+    size_t index = SIZE_MAX;
+    ASSERT_EQ(disruptor::Simd::min_of_pointed(values.data(), values.size(), index), 4);
+    ASSERT_EQ(index, 2);
+}
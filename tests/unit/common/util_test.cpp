@@ -26,3 +26,35 @@ TEST(UtilTest, ShouldGetCacheLineSize) {
     // Check if it's a power of two
     ASSERT_EQ((cacheLineSize & (cacheLineSize - 1)), 0);
 }
+
+TEST(UtilTest, ShouldFollowBackoffPolicyPhases) {
+    constexpr disruptor::BackoffPolicy policy{2, 1, std::chrono::nanoseconds(1)};
+    int wait_counter = 0;
+
+    // spin, spin, yield
+    disruptor::Util::adaptive_wait(wait_counter, policy);
+    disruptor::Util::adaptive_wait(wait_counter, policy);
+    disruptor::Util::adaptive_wait(wait_counter, policy);
+    ASSERT_EQ(wait_counter, 3);
+
+    // park, then back to the yield phase
+    disruptor::Util::adaptive_wait(wait_counter, policy);
+    ASSERT_EQ(wait_counter, policy.spin_tries);
+}
+
+TEST(UtilTest, ShouldBoundTimeUntilDeadline) {
+    constexpr auto upper_bound = std::chrono::milliseconds(5);
+    ASSERT_EQ(disruptor::Util::time_until(disruptor::NO_DEADLINE, upper_bound), upper_bound);
+    ASSERT_EQ(disruptor::Util::time_until(std::chrono::steady_clock::now() - std::chrono::seconds(1), upper_bound),
+              std::chrono::nanoseconds(0));
+    ASSERT_LE(disruptor::Util::time_until(std::chrono::steady_clock::now() + std::chrono::seconds(1), upper_bound),
+              upper_bound);
+}
+
+TEST(UtilTest, ShouldParkForAtLeastTheRequestedDuration) {
+    constexpr auto duration = std::chrono::microseconds(200);
+
+    const auto start = std::chrono::steady_clock::now();
+    disruptor::Util::precise_park(duration, std::chrono::nanoseconds(1));
+    ASSERT_GE(std::chrono::steady_clock::now() - start, duration);
+}
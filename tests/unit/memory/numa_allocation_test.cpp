@@ -0,0 +1,118 @@
+#include <gtest/gtest.h>
+#include <thread>
+
+#if defined(__linux__)
+#include <linux/mempolicy.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include "NumaAllocation.hpp"
+#include "RingBuffer.hpp"
+#include "MultiProducerSequencer.hpp"
+#include "SingleProducerSequencer.hpp"
+
+using namespace disruptor;
+
+namespace {
+    struct Event {
+        size_t value = 0;
+    };
+
+    constexpr size_t BUFFER_SIZE = 1024;
+
+    struct Tracked {
+        static inline int destroyed = 0;
+        std::thread::id constructed_on;
+
+        Tracked() : constructed_on(std::this_thread::get_id()) {
+        }
+
+        ~Tracked() {
+            ++destroyed;
+        }
+    };
+
+    struct Throwing {
+        Throwing() {
+            throw std::runtime_error("constructor failed");
+        }
+    };
+}
+
+TEST(NumaAllocationTest, ShouldConstructRingBufferOnNode) {
+    for (const auto placement: {NumaPlacement::BIND, NumaPlacement::FIRST_TOUCH}) {
+        auto ring_buffer = NumaAllocation::make_on_node<RingBuffer<Event, BUFFER_SIZE> >(
+            {0, placement}, [] { return Event{}; });
+
+        ASSERT_NE(ring_buffer, nullptr);
+        EXPECT_EQ(reinterpret_cast<uintptr_t>(ring_buffer.get()) % NumaAllocation::page_size(), 0);
+        ring_buffer->get(BUFFER_SIZE - 1).value = 42;
+        EXPECT_EQ(ring_buffer->get(BUFFER_SIZE - 1).value, 42);
+
+#if defined(__linux__)
+        const int node = NumaAllocation::get_node_of(ring_buffer.get());
+        // kernels without NUMA support report -1
+        EXPECT_TRUE(node == 0 || node == -1);
+#endif
+    }
+}
+
+TEST(NumaAllocationTest, BindShouldPlaceDynamicRingSlotsOnNode) {
+    constexpr size_t dynamic_buffer_size = 1 << 16;
+    auto ring_buffer = NumaAllocation::make_on_node<RingBuffer<Event, DYNAMIC_SIZE> >(
+        {0, NumaPlacement::BIND}, dynamic_buffer_size, [] { return Event{}; });
+    auto sequencer = NumaAllocation::make_on_node<MultiProducerSequencer<Event, DYNAMIC_SIZE, 1> >(
+        {0, NumaPlacement::BIND}, *ring_buffer);
+
+    ASSERT_NE(ring_buffer, nullptr);
+    ASSERT_NE(sequencer, nullptr);
+#if defined(__linux__)
+    // the slots are a mapping of their own, outside the mbind-ed object
+    const int node = NumaAllocation::get_node_of(&ring_buffer->get(dynamic_buffer_size - 1));
+    EXPECT_TRUE(node == 0 || node == -1);
+
+    // the calling thread gets its own memory policy back
+    int mode = -1;
+    ASSERT_EQ(syscall(SYS_get_mempolicy, &mode, nullptr, 0, nullptr, 0), 0);
+    EXPECT_EQ(mode, MPOL_DEFAULT);
+#endif
+}
+
+TEST(NumaAllocationTest, ShouldConstructSequencersOnNode) {
+    RingBuffer<Event, BUFFER_SIZE> ring_buffer([] { return Event{}; });
+
+    auto single = NumaAllocation::make_on_node<SingleProducerSequencer<Event, BUFFER_SIZE, 1> >({0}, ring_buffer);
+    auto multi = NumaAllocation::make_on_node<MultiProducerSequencer<Event, BUFFER_SIZE, 1> >(
+        {0, NumaPlacement::FIRST_TOUCH}, ring_buffer);
+
+    EXPECT_EQ(single->get_cursor().get(), BUFFER_SIZE);
+    EXPECT_EQ(multi->get_cursor().get(), BUFFER_SIZE);
+}
+
+TEST(NumaAllocationTest, FirstTouchShouldConstructOnAnotherThread) {
+    Tracked::destroyed = 0;
+    {
+        const auto tracked = NumaAllocation::make_on_node<Tracked>({0, NumaPlacement::FIRST_TOUCH});
+#if defined(__linux__)
+        EXPECT_NE(tracked->constructed_on, std::this_thread::get_id());
+#endif
+    }
+    EXPECT_EQ(Tracked::destroyed, 1);
+}
+
+TEST(NumaAllocationTest, FirstTouchShouldRejectNodeWithoutCpus) {
+#if defined(__linux__)
+    Tracked::destroyed = 0;
+    EXPECT_THROW((void)NumaAllocation::make_on_node<Tracked>({4096, NumaPlacement::FIRST_TOUCH}),
+                 std::invalid_argument);
+    EXPECT_THROW((void)NumaAllocation::make_on_node<Tracked>({-1, NumaPlacement::FIRST_TOUCH}),
+                 std::invalid_argument);
+    EXPECT_EQ(Tracked::destroyed, 0);
+#endif
+}
+
+TEST(NumaAllocationTest, ShouldPropagateConstructorException) {
+    EXPECT_THROW((void)NumaAllocation::make_on_node<Throwing>({0, NumaPlacement::BIND}), std::runtime_error);
+    EXPECT_THROW((void)NumaAllocation::make_on_node<Throwing>({0, NumaPlacement::FIRST_TOUCH}), std::runtime_error);
+}
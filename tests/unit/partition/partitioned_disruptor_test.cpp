@@ -0,0 +1,150 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "PartitionedDisruptor.hpp"
+#include "SingleProducerSequencer.hpp"
+#include "MultiProducerSequencer.hpp"
+#include "TestEvent.hpp"
+
+using namespace disruptor;
+
+namespace {
+    constexpr size_t BUFFER_SIZE = 64;
+
+    template<typename Condition>
+    void wait_until(Condition &&condition) {
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+        while (!condition() && std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+}
+
+TEST(PartitionedDisruptorTest, ShouldRejectInvalidConfiguration) {
+    using Disruptor = PartitionedDisruptor<TestEvent, BUFFER_SIZE, SingleProducerSequencer, WaitStrategyType::ADAPTIVE>;
+    const auto one_stage = [](size_t) {
+        return std::vector<Disruptor::EventHandler>{[](TestEvent &, size_t, bool) {}};
+    };
+
+    EXPECT_THROW(Disruptor(0, createTestEvent, one_stage), std::invalid_argument);
+    EXPECT_THROW(Disruptor(2, createTestEvent, [](size_t) { return std::vector<Disruptor::EventHandler>{}; }),
+                 std::invalid_argument);
+}
+
+TEST(PartitionedDisruptorTest, ShouldReportPerPartitionBackpressure) {
+    using Disruptor = PartitionedDisruptor<TestEvent, BUFFER_SIZE, SingleProducerSequencer, WaitStrategyType::ADAPTIVE>;
+    Disruptor disruptor(4, createTestEvent, [](size_t) {
+        return std::vector<Disruptor::EventHandler>{[](TestEvent &, size_t, bool) {}};
+    });
+
+    // processors not started: the published events stay in their partition
+    for (int i = 0; i < 3; ++i) {
+        disruptor.publish(5, [i](TestEvent &event, size_t) { event.value = i; });
+    }
+    disruptor.publish(2, [](TestEvent &event, size_t) { event.value = 100; });
+
+    EXPECT_EQ(disruptor.get_partition_of(5), 1);
+    EXPECT_EQ(disruptor.get_remaining_capacity(0), BUFFER_SIZE);
+    EXPECT_EQ(disruptor.get_remaining_capacity(1), BUFFER_SIZE - 3);
+    EXPECT_EQ(disruptor.get_remaining_capacity(2), BUFFER_SIZE - 1);
+
+    const PartitionStats stats = disruptor.get_stats(1);
+    EXPECT_EQ(stats.published, 3);
+    EXPECT_EQ(stats.processed, 0);
+
+    const PartitionStats total = disruptor.get_aggregate_stats();
+    EXPECT_EQ(total.published, 4);
+    EXPECT_EQ(total.processed, 0);
+    EXPECT_EQ(total.remaining_capacity, 4 * BUFFER_SIZE - 4);
+}
+
+TEST(PartitionedDisruptorTest, EventsOfOneKeyShouldGoThroughTheChainOfOnePartitionInOrder) {
+    constexpr size_t NUM_PARTITIONS = 3;
+    constexpr size_t NUM_KEYS = 12;
+    constexpr size_t NUM_EVENTS = 30'000;
+
+    using Disruptor = PartitionedDisruptor<TestEvent, BUFFER_SIZE, SingleProducerSequencer, WaitStrategyType::ADAPTIVE>;
+
+    // stage 0 tags the event, stage 1 checks the tag and the per key order (counter in "value")
+    std::vector<std::vector<long> > last_counter(NUM_PARTITIONS, std::vector<long>(NUM_KEYS, -1));
+    std::atomic<size_t> errors{0};
+    Disruptor disruptor(NUM_PARTITIONS, createTestEvent, [&](const size_t partition) {
+        return std::vector<Disruptor::EventHandler>{
+            [partition](TestEvent &event, size_t, bool) {
+                event.message += "@" + std::to_string(partition);
+            },
+            [&, partition](const TestEvent &event, size_t, bool) {
+                const size_t key = std::stoul(event.message.substr(0, event.message.find('@')));
+                const bool tagged = event.message.ends_with("@" + std::to_string(partition));
+                if (!tagged || key % NUM_PARTITIONS != partition || event.value != last_counter[partition][key] + 1) {
+                    errors.fetch_add(1, std::memory_order_relaxed);
+                }
+                last_counter[partition][key] = event.value;
+            }
+        };
+    });
+
+    std::vector<std::thread> threads = disruptor.start();
+    ASSERT_EQ(threads.size(), NUM_PARTITIONS * 2);
+
+    std::vector<long> counters(NUM_KEYS, 0);
+    for (size_t i = 0; i < NUM_EVENTS; ++i) {
+        const size_t key = (i * 5) % NUM_KEYS;
+        disruptor.publish(key, [&](TestEvent &event, size_t) {
+            event.value = counters[key]++;
+            event.message = std::to_string(key);
+        });
+    }
+
+    wait_until([&] { return disruptor.get_aggregate_stats().processed == NUM_EVENTS; });
+    disruptor.halt();
+    for (auto &thread: threads) {
+        thread.join();
+    }
+
+    const PartitionStats total = disruptor.get_aggregate_stats();
+    EXPECT_EQ(total.published, NUM_EVENTS);
+    EXPECT_EQ(total.processed, NUM_EVENTS);
+    EXPECT_EQ(total.remaining_capacity, NUM_PARTITIONS * BUFFER_SIZE);
+    EXPECT_EQ(errors.load(), 0);
+}
+
+TEST(PartitionedDisruptorTest, MultiProducerPartitionsShouldAcceptConcurrentProducers) {
+    constexpr size_t NUM_PARTITIONS = 2;
+    constexpr size_t EVENTS_PER_PRODUCER = 10'000;
+
+    using Disruptor = PartitionedDisruptor<TestEvent, BUFFER_SIZE, MultiProducerSequencer, WaitStrategyType::YIELD>;
+    std::vector<std::atomic<size_t> > handled(NUM_PARTITIONS);
+    Disruptor disruptor(NUM_PARTITIONS, createTestEvent, [&](const size_t partition) {
+        return std::vector<Disruptor::EventHandler>{
+            [&, partition](TestEvent &, size_t, bool) { handled[partition].fetch_add(1, std::memory_order_relaxed); }
+        };
+    });
+    std::vector<std::thread> threads = disruptor.start();
+
+    std::vector<std::thread> producers;
+    for (size_t p = 0; p < 3; ++p) {
+        producers.emplace_back([&, p] {
+            for (size_t i = 0; i < EVENTS_PER_PRODUCER; ++i) {
+                disruptor.publish(p + i, [&](TestEvent &event, size_t) { event.value = static_cast<long>(i); });
+            }
+        });
+    }
+    for (auto &producer: producers) {
+        producer.join();
+    }
+
+    wait_until([&] { return disruptor.get_aggregate_stats().processed == 3 * EVENTS_PER_PRODUCER; });
+    disruptor.halt();
+    for (auto &thread: threads) {
+        thread.join();
+    }
+
+    EXPECT_EQ(disruptor.get_aggregate_stats().processed, 3 * EVENTS_PER_PRODUCER);
+    EXPECT_EQ(handled[0].load() + handled[1].load(), 3 * EVENTS_PER_PRODUCER);
+    EXPECT_GT(handled[0].load(), 0);
+    EXPECT_GT(handled[1].load(), 0);
+}
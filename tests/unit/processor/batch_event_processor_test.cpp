@@ -5,11 +5,16 @@
 #include <chrono>
 #include <vector>
 #include <atomic>
+#include <optional>
+#include <span>
 #include "BatchEventProcessor.hpp"
 #include "Sequence.hpp"
 #include "SequenceBarrier.hpp"
 #include "RingBuffer.hpp"
 #include "AlertException.hpp"
+#include "TimeoutException.hpp"
+#include "ProcessingSequenceBarrier.hpp"
+#include "SingleProducerSequencer.hpp"
 #include "TestEvent.hpp"
 
 using namespace testing;
@@ -19,6 +24,7 @@ using namespace disruptor;
 class MockSequenceBarrier final : public SequenceBarrier {
 public:
     MOCK_METHOD(size_t, wait_for, (size_t sequence), (override));
+    MOCK_METHOD(size_t, wait_for, (size_t sequence, Deadline deadline), (override));
     MOCK_METHOD(bool, is_alerted, (), (const, override));
     MOCK_METHOD(void, alert, (), (override));
     MOCK_METHOD(void, clear_alert, (), (override));
@@ -333,3 +339,261 @@ TEST_F(BatchEventProcessorTest, BatchSizeLargerThanRingBuffer) {
     // Kiểm tra cursor đã được cập nhật
     EXPECT_EQ(processor.get_cursor().get_with_acquire(), BUFFER_SIZE + 20);
 }
+
+// Test timeout: handler được gọi với sequence cuối cùng đã xử lý khi không có sự kiện mới
+TEST_F(BatchEventProcessorTest, TimeoutInvokesTimeoutHandler) {
+    BatchEventProcessor<TestEvent, BUFFER_SIZE> processor(*sequence_barrier, event_handler, *ring_buffer);
+
+    std::vector<size_t> timeout_sequences;
+    processor.set_timeout_handler([&](const size_t sequence) {
+        timeout_sequences.push_back(sequence);
+    }, std::chrono::milliseconds(10));
+
+    // Batch 1: BUFFER_SIZE+1 đến BUFFER_SIZE+2, sau đó timeout 2 lần rồi dừng
+    EXPECT_CALL(*sequence_barrier, wait_for(BUFFER_SIZE + 1, _))
+            .WillOnce(Return(BUFFER_SIZE + 2));
+
+    EXPECT_CALL(*sequence_barrier, wait_for(BUFFER_SIZE + 3, _))
+            .WillOnce(Throw(TimeoutException()))
+            .WillOnce(Throw(TimeoutException()))
+            .WillOnce(Throw(AlertException()));
+
+    EXPECT_CALL(*sequence_barrier, clear_alert())
+            .Times(1);
+
+    processor.run();
+
+    ASSERT_EQ(processed_sequences.size(), 2);
+    ASSERT_EQ(timeout_sequences.size(), 2);
+    EXPECT_EQ(timeout_sequences[0], BUFFER_SIZE + 2);
+    EXPECT_EQ(timeout_sequences[1], BUFFER_SIZE + 2);
+}
+
+// Test processor cập nhật GatingTree sau mỗi batch
+TEST_F(BatchEventProcessorTest, RefreshesGatingNodeAfterBatch) {
+    BatchEventProcessor<TestEvent, BUFFER_SIZE> processor(*sequence_barrier, event_handler, *ring_buffer);
+    disruptor::Sequence other_consumer(BUFFER_SIZE + 10);
+    GatingTree tree({processor.get_cursor(), other_consumer});
+    processor.set_gating_node(tree.get_parent_of(0));
+
+    EXPECT_CALL(*sequence_barrier, clear_alert()).Times(1);
+    EXPECT_CALL(*sequence_barrier, wait_for(BUFFER_SIZE + 1)).WillOnce(Return(BUFFER_SIZE + 4));
+    EXPECT_CALL(*sequence_barrier, wait_for(BUFFER_SIZE + 5)).WillOnce(Throw(AlertException()));
+
+    EXPECT_EQ(tree.get_root().get_with_acquire(), BUFFER_SIZE);
+    std::thread processor_thread([&processor]() {
+        processor.run();
+    });
+    processor_thread.join();
+
+    EXPECT_EQ(tree.get_root().get_with_acquire(), BUFFER_SIZE + 4);
+}
+
+// Test handler truyền theo kiểu (lambda/functor) thay vì std::function
+TEST_F(BatchEventProcessorTest, ProcessesBatchWithHandlerType) {
+    struct SumHandler {
+        long sum = 0;
+        size_t batches = 0;
+
+        void operator()(const TestEvent &event, size_t, const bool end_of_batch) {
+            sum += event.value;
+            batches += end_of_batch;
+        }
+    };
+    static_assert(EventHandlerFor<SumHandler, TestEvent>);
+    static_assert(!EventHandlerFor<int, TestEvent>);
+
+    BatchEventProcessor<TestEvent, BUFFER_SIZE, SumHandler> processor(*sequence_barrier, SumHandler{}, *ring_buffer);
+
+    EXPECT_CALL(*sequence_barrier, clear_alert()).Times(1);
+    EXPECT_CALL(*sequence_barrier, wait_for(BUFFER_SIZE + 1)).WillOnce(Return(BUFFER_SIZE + 3));
+    EXPECT_CALL(*sequence_barrier, wait_for(BUFFER_SIZE + 4)).WillOnce(Throw(AlertException()));
+
+    std::thread processor_thread([&processor]() {
+        processor.run();
+    });
+    processor_thread.join();
+
+    EXPECT_EQ(processor.get_cursor().get_with_acquire(), BUFFER_SIZE + 3);
+    EXPECT_EQ(processor.get_event_handler().sum, 10 + 20 + 30);
+    EXPECT_EQ(processor.get_event_handler().batches, 1);
+}
+
+// Test handler on_batch: cả batch trong một lần gọi, tách thành hai span ở chỗ ring buffer quay vòng
+TEST_F(BatchEventProcessorTest, ProcessesBatchAsSpansSplitAtWrapPoint) {
+    struct SpanHandler {
+        std::vector<std::pair<size_t, size_t> > span_sizes;
+        std::vector<size_t> first_sequences;
+        long sum = 0;
+
+        void on_batch(const std::span<TestEvent> first, const std::span<TestEvent> second,
+                      const size_t first_sequence) {
+            span_sizes.emplace_back(first.size(), second.size());
+            first_sequences.push_back(first_sequence);
+            for (const TestEvent &event: first) {
+                sum += event.value;
+            }
+            for (const TestEvent &event: second) {
+                sum += event.value;
+            }
+        }
+    };
+    static_assert(SpanHandlerFor<SpanHandler, TestEvent>);
+    static_assert(!EventHandlerFor<SpanHandler, TestEvent>);
+
+    BatchEventProcessor<TestEvent, BUFFER_SIZE, SpanHandler> processor(*sequence_barrier, SpanHandler{}, *ring_buffer);
+
+    EXPECT_CALL(*sequence_barrier, clear_alert()).Times(1);
+    // batch 1: slots 1..13, batch 2: slots 14, 15, 0, 1 (quay vòng)
+    EXPECT_CALL(*sequence_barrier, wait_for(BUFFER_SIZE + 1)).WillOnce(Return(BUFFER_SIZE + 13));
+    EXPECT_CALL(*sequence_barrier, wait_for(BUFFER_SIZE + 14)).WillOnce(Return(BUFFER_SIZE + 17));
+    EXPECT_CALL(*sequence_barrier, wait_for(BUFFER_SIZE + 18)).WillOnce(Throw(AlertException()));
+
+    std::thread processor_thread([&processor]() {
+        processor.run();
+    });
+    processor_thread.join();
+
+    const SpanHandler &handler = processor.get_event_handler();
+    ASSERT_EQ(handler.span_sizes.size(), 2);
+    EXPECT_EQ(handler.span_sizes[0], std::make_pair(size_t{13}, size_t{0}));
+    EXPECT_EQ(handler.span_sizes[1], std::make_pair(size_t{2}, size_t{2}));
+    EXPECT_EQ(handler.first_sequences, (std::vector<size_t>{BUFFER_SIZE + 1, BUFFER_SIZE + 14}));
+    // giá trị của slot i là i * 10
+    EXPECT_EQ(handler.sum, 10 * (13 * 14 / 2) + 10 * (14 + 15 + 0 + 1));
+    EXPECT_EQ(processor.get_cursor().get_with_acquire(), BUFFER_SIZE + 17);
+}
+
+// Test max batch size: batch lớn được chia nhỏ, sequence được release sau mỗi phần
+TEST_F(BatchEventProcessorTest, LimitsBatchToMaxBatchSize) {
+    std::vector<size_t> cursor_before_event;
+    BatchEventProcessor<TestEvent, BUFFER_SIZE> *processor_ptr = nullptr;
+    BatchEventProcessor<TestEvent, BUFFER_SIZE> processor(
+        *sequence_barrier, [&](TestEvent &event, const size_t sequence, const bool end_of_batch) {
+            cursor_before_event.push_back(processor_ptr->get_cursor().get_with_acquire());
+            event_handler(event, sequence, end_of_batch);
+        }, *ring_buffer);
+    processor_ptr = &processor;
+    EXPECT_THROW(processor.set_max_batch_size(0), std::invalid_argument);
+    processor.set_max_batch_size(4);
+
+    EXPECT_CALL(*sequence_barrier, clear_alert()).Times(1);
+    // 10 event sẵn sàng trong một lần wait_for, barrier chỉ được gọi lại khi đã xử lý hết
+    EXPECT_CALL(*sequence_barrier, wait_for(BUFFER_SIZE + 1)).WillOnce(Return(BUFFER_SIZE + 10));
+    EXPECT_CALL(*sequence_barrier, wait_for(BUFFER_SIZE + 11)).WillOnce(Throw(AlertException()));
+
+    std::thread processor_thread([&processor]() {
+        processor.run();
+    });
+    processor_thread.join();
+
+    EXPECT_EQ(processed_sequences.size(), 10);
+    EXPECT_EQ(batch_ends, (std::vector<size_t>{BUFFER_SIZE + 4, BUFFER_SIZE + 8, BUFFER_SIZE + 10}));
+    ASSERT_EQ(cursor_before_event.size(), 10);
+    EXPECT_EQ(cursor_before_event[0], BUFFER_SIZE);
+    EXPECT_EQ(cursor_before_event[4], BUFFER_SIZE + 4);
+    EXPECT_EQ(cursor_before_event[8], BUFFER_SIZE + 8);
+    EXPECT_EQ(processor.get_cursor().get_with_acquire(), BUFFER_SIZE + 10);
+}
+
+// Test SequenceCallback: handler release từng event ngay trong batch (như SequenceReportingEventHandler của Java)
+TEST_F(BatchEventProcessorTest, HandlerReportsProgressMidBatch) {
+    struct ReportingHandler {
+        std::optional<SequenceCallback> callback;
+        const disruptor::Sequence *cursor = nullptr;
+        std::vector<size_t> cursor_before_event;
+
+        void set_sequence_callback(const SequenceCallback sequence_callback) {
+            callback = sequence_callback;
+        }
+
+        void operator()(TestEvent &, const size_t sequence, bool) {
+            cursor_before_event.push_back(cursor->get());
+            callback->set(sequence);
+        }
+    };
+    static_assert(SequenceReportingHandler<ReportingHandler>);
+
+    BatchEventProcessor<TestEvent, BUFFER_SIZE, ReportingHandler> processor(
+        *sequence_barrier, ReportingHandler{}, *ring_buffer);
+    processor.get_event_handler().cursor = &processor.get_cursor();
+
+    EXPECT_CALL(*sequence_barrier, clear_alert()).Times(1);
+    EXPECT_CALL(*sequence_barrier, wait_for(BUFFER_SIZE + 1)).WillOnce(Return(BUFFER_SIZE + 3));
+    EXPECT_CALL(*sequence_barrier, wait_for(BUFFER_SIZE + 4)).WillOnce(Throw(AlertException()));
+
+    std::thread processor_thread([&processor]() {
+        processor.run();
+    });
+    processor_thread.join();
+
+    EXPECT_EQ(processor.get_event_handler().cursor_before_event,
+              (std::vector<size_t>{BUFFER_SIZE, BUFFER_SIZE + 1, BUFFER_SIZE + 2}));
+    EXPECT_EQ(processor.get_cursor().get_with_acquire(), BUFFER_SIZE + 3);
+}
+
+// Test pipeline tĩnh: kiểu của handler và barrier được suy ra từ constructor, không qua vtable
+TEST(BatchEventProcessorStaticTest, RunsWithDeducedBarrierAndHandlerTypes) {
+    constexpr size_t SIZE = 16;
+    constexpr size_t NUM_EVENTS = 1'000;
+    RingBuffer<TestEvent, SIZE> ring_buffer(createTestEvent);
+    using Producer = SingleProducerSequencer<TestEvent, SIZE, 1>;
+    Producer sequencer(ring_buffer);
+    using Barrier = ProcessingSequenceBarrier<WaitStrategyType::ADAPTIVE, 1, Producer>;
+    Barrier barrier(true, {sequencer.get_cursor()}, sequencer);
+
+    std::atomic<long> sum{0};
+    auto handler = [&sum](const TestEvent &event, size_t, bool) {
+        sum.fetch_add(event.value, std::memory_order_relaxed);
+    };
+    BatchEventProcessor processor(barrier, handler, ring_buffer);
+    static_assert(std::is_same_v<decltype(processor), BatchEventProcessor<TestEvent, SIZE, decltype(handler), Barrier> >);
+    sequencer.add_gating_sequences({processor.get_cursor()});
+
+    std::thread processor_thread([&processor]() {
+        processor.run();
+    });
+
+    for (size_t i = 0; i < NUM_EVENTS; ++i) {
+        const size_t sequence = sequencer.next(1);
+        ring_buffer.get(sequence).value = static_cast<long>(i);
+        sequencer.publish(sequence);
+    }
+    const size_t last_published = sequencer.get_cursor().get_with_acquire();
+    while (processor.get_cursor().get_with_acquire() < last_published) {
+        std::this_thread::yield();
+    }
+    processor.halt();
+    processor_thread.join();
+
+    EXPECT_EQ(sum.load(), static_cast<long>(NUM_EVENTS * (NUM_EVENTS - 1) / 2));
+}
+
+// Test std::jthread: request_stop() (hoặc destructor của jthread) dừng processor qua stop_token, không cần halt()
+TEST(BatchEventProcessorStaticTest, StopsWhenJthreadIsStopped) {
+    constexpr size_t SIZE = 16;
+    RingBuffer<TestEvent, SIZE> ring_buffer(createTestEvent);
+    using Producer = SingleProducerSequencer<TestEvent, SIZE, 1>;
+    Producer sequencer(ring_buffer);
+    ProcessingSequenceBarrier<WaitStrategyType::ADAPTIVE, 1, Producer> barrier(
+        true, {sequencer.get_cursor()}, sequencer);
+
+    std::atomic<size_t> handled{0};
+    BatchEventProcessor processor(barrier, [&handled](TestEvent &, size_t, bool) {
+        handled.fetch_add(1, std::memory_order_release);
+    }, ring_buffer);
+    sequencer.add_gating_sequences({processor.get_cursor()});
+
+    std::jthread processor_thread = processor.start_jthread({});
+    const size_t sequence = sequencer.next(1);
+    sequencer.publish(sequence);
+    while (handled.load(std::memory_order_acquire) < 1) {
+        std::this_thread::yield();
+    }
+
+    processor_thread.request_stop();
+    processor_thread.join();
+
+    EXPECT_TRUE(barrier.is_alerted());
+    EXPECT_EQ(processor.get_cursor().get_with_acquire(), sequence);
+}
@@ -0,0 +1,214 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "FanInProcessor.hpp"
+#include "RingBuffer.hpp"
+#include "SingleProducerSequencer.hpp"
+#include "TestEvent.hpp"
+
+using namespace disruptor;
+
+namespace {
+    constexpr size_t BUFFER_SIZE = 64;
+    constexpr size_t NUM_SOURCES = 3;
+
+    using Ring = RingBuffer<TestEvent, BUFFER_SIZE>;
+    using Producer = SingleProducerSequencer<TestEvent, BUFFER_SIZE, 1>;
+
+    struct Handled {
+        size_t source;
+        size_t sequence;
+        long value;
+        bool end_of_batch;
+    };
+
+    struct Sources {
+        std::vector<std::unique_ptr<Ring> > rings;
+        std::vector<std::unique_ptr<Producer> > sequencers;
+
+        void attach(FanInProcessor<TestEvent, BUFFER_SIZE> &processor) {
+            for (size_t i = 0; i < NUM_SOURCES; ++i) {
+                rings.push_back(std::make_unique<Ring>(createTestEvent));
+                sequencers.push_back(std::make_unique<Producer>(*rings.back()));
+                ASSERT_EQ(processor.add_source(*rings.back(), *sequencers.back(), sequencers.back()->get_cursor()), i);
+                sequencers.back()->add_gating_sequences({processor.get_cursor(i)});
+            }
+        }
+
+        void publish(const size_t source, const long value) {
+            const size_t sequence = sequencers[source]->next(1);
+            rings[source]->get(sequence).value = value;
+            sequencers[source]->publish(sequence);
+        }
+    };
+}
+
+TEST(FanInProcessorTest, ShouldRejectEmptyBatch) {
+    EXPECT_THROW((FanInProcessor<TestEvent, BUFFER_SIZE>([](TestEvent &, size_t, size_t, bool) {}, 0)),
+                 std::invalid_argument);
+}
+
+TEST(FanInProcessorTest, RoundRobinShouldBoundEachSourceToTheBatchSize) {
+    std::vector<Handled> handled;
+    FanInProcessor<TestEvent, BUFFER_SIZE> processor(
+        [&](const TestEvent &event, const size_t source, const size_t sequence, const bool end_of_batch) {
+            handled.push_back({source, sequence, event.value, end_of_batch});
+            if (handled.size() == 6) {
+                processor.halt();
+            }
+        }, 2);
+    Sources sources;
+    sources.attach(processor);
+
+    // source 0 has 3 events, source 2 has 1, source 1 nothing
+    sources.publish(0, 10);
+    sources.publish(0, 11);
+    sources.publish(0, 12);
+    sources.publish(2, 20);
+    sources.publish(1, 30);
+    sources.publish(1, 31);
+
+    processor.run();
+
+    // round 1: two of source 0 (batch size), both of source 1, the one of source 2; round 2: the rest of source 0
+    ASSERT_EQ(handled.size(), 6);
+    const std::vector<std::pair<size_t, long> > expected{{0, 10}, {0, 11}, {1, 30}, {1, 31}, {2, 20}, {0, 12}};
+    for (size_t i = 0; i < expected.size(); ++i) {
+        EXPECT_EQ(handled[i].source, expected[i].first) << i;
+        EXPECT_EQ(handled[i].value, expected[i].second) << i;
+        EXPECT_EQ(handled[i].end_of_batch, i == 4 || i == 5) << i;
+    }
+    EXPECT_EQ(handled[5].sequence, BUFFER_SIZE + 3);
+    EXPECT_EQ(processor.get_cursor(0).get_with_acquire(), BUFFER_SIZE + 3);
+    EXPECT_EQ(processor.get_cursor(1).get_with_acquire(), BUFFER_SIZE + 2);
+    EXPECT_EQ(processor.get_cursor(2).get_with_acquire(), BUFFER_SIZE + 1);
+}
+
+TEST(FanInProcessorTest, TimestampMergeShouldHandleEventsInTimeOrder) {
+    constexpr size_t EVENTS_PER_SOURCE = 20;
+
+    std::vector<long> timestamps;
+    FanInProcessor<TestEvent, BUFFER_SIZE> processor(
+        [&](const TestEvent &event, size_t, size_t, bool) {
+            timestamps.push_back(event.value);
+            if (timestamps.size() == NUM_SOURCES * EVENTS_PER_SOURCE) {
+                processor.halt();
+            }
+        });
+    processor.set_timestamp_merge([](const TestEvent &event) { return static_cast<uint64_t>(event.value); });
+    Sources sources;
+    sources.attach(processor);
+
+    // interleaved clocks: source s publishes s, s + 3, s + 6... and source 2 is published first
+    for (size_t s = NUM_SOURCES; s-- > 0;) {
+        for (size_t i = 0; i < EVENTS_PER_SOURCE; ++i) {
+            sources.publish(s, static_cast<long>(i * NUM_SOURCES + s));
+        }
+    }
+
+    processor.run();
+
+    ASSERT_EQ(timestamps.size(), NUM_SOURCES * EVENTS_PER_SOURCE);
+    for (size_t i = 0; i < timestamps.size(); ++i) {
+        EXPECT_EQ(timestamps[i], static_cast<long>(i));
+    }
+}
+
+TEST(FanInProcessorTest, TimestampMergeShouldHoldEventsBackUntilEverySourceCaughtUp) {
+    std::vector<long> timestamps;
+    std::atomic<size_t> handled{0};
+    FanInProcessor<TestEvent, BUFFER_SIZE> processor(
+        [&](const TestEvent &event, size_t, size_t, bool) {
+            timestamps.push_back(event.value);
+            handled.fetch_add(1, std::memory_order_release);
+        });
+    // long enough for the test to never see a source go idle
+    processor.set_timestamp_merge([](const TestEvent &event) { return static_cast<uint64_t>(event.value); },
+                                  std::chrono::seconds(30));
+    Sources sources;
+    sources.attach(processor);
+
+    const auto wait_for_handled = [&handled](const size_t count) {
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+        while (handled.load(std::memory_order_acquire) < count && std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    };
+
+    sources.publish(1, 10);
+    sources.publish(2, 12);
+    std::thread consumer = processor.start({});
+
+    // source 0 has not published yet, it may still publish something older than 10
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    EXPECT_EQ(handled.load(std::memory_order_acquire), 0);
+
+    // published rounds after 10 and 12 were seen, still handed out first
+    sources.publish(0, 5);
+    sources.publish(0, 20);
+    wait_for_handled(2);
+
+    // once 10 is handed out source 1 is empty and may still publish 11: 12 waits for it
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    EXPECT_EQ(handled.load(std::memory_order_acquire), 2);
+
+    sources.publish(1, 21);
+    sources.publish(2, 22);
+    wait_for_handled(4);
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+    processor.halt();
+    consumer.join();
+
+    EXPECT_EQ(timestamps, (std::vector<long>{5, 10, 12, 20}));
+    // 21 and 22 wait for source 0 to reach them
+    EXPECT_EQ(processor.get_cursor(0).get_with_acquire(), BUFFER_SIZE + 2);
+    EXPECT_EQ(processor.get_cursor(1).get_with_acquire(), BUFFER_SIZE + 1);
+    EXPECT_EQ(processor.get_cursor(2).get_with_acquire(), BUFFER_SIZE + 1);
+}
+
+TEST(FanInProcessorTest, ShouldDrainOneProducerThreadPerRing) {
+    constexpr size_t EVENTS_PER_SOURCE = 20'000;
+
+    std::vector<long> last_value(NUM_SOURCES, -1);
+    std::atomic<size_t> total{0};
+    std::atomic<size_t> out_of_order{0};
+    FanInProcessor<TestEvent, BUFFER_SIZE> processor(
+        [&](const TestEvent &event, const size_t source, size_t, bool) {
+            if (event.value != last_value[source] + 1) {
+                out_of_order.fetch_add(1, std::memory_order_relaxed);
+            }
+            last_value[source] = event.value;
+            total.fetch_add(1, std::memory_order_release);
+        }, 16);
+    Sources sources;
+    sources.attach(processor);
+
+    std::thread consumer = processor.start({});
+    std::vector<std::thread> producers;
+    for (size_t s = 0; s < NUM_SOURCES; ++s) {
+        producers.emplace_back([&, s] {
+            for (size_t i = 0; i < EVENTS_PER_SOURCE; ++i) {
+                sources.publish(s, static_cast<long>(i));
+            }
+        });
+    }
+    for (auto &producer: producers) {
+        producer.join();
+    }
+
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (total.load(std::memory_order_acquire) < NUM_SOURCES * EVENTS_PER_SOURCE
+           && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    processor.halt();
+    consumer.join();
+
+    EXPECT_EQ(total.load(), NUM_SOURCES * EVENTS_PER_SOURCE);
+    EXPECT_EQ(out_of_order.load(), 0);
+}
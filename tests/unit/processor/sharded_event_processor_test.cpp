@@ -0,0 +1,137 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "ShardedEventProcessor.hpp"
+#include "ShardedProcessorGroup.hpp"
+#include "RingBuffer.hpp"
+#include "SingleProducerSequencer.hpp"
+#include "AlertException.hpp"
+#include "TestEvent.hpp"
+
+using namespace testing;
+using namespace disruptor;
+
+namespace {
+    constexpr size_t BUFFER_SIZE = 16;
+
+    class MockSequenceBarrier final : public SequenceBarrier {
+    public:
+        MOCK_METHOD(size_t, wait_for, (size_t sequence), (override));
+        MOCK_METHOD(size_t, wait_for, (size_t sequence, Deadline deadline), (override));
+        MOCK_METHOD(bool, is_alerted, (), (const, override));
+        MOCK_METHOD(void, alert, (), (override));
+        MOCK_METHOD(void, clear_alert, (), (override));
+        MOCK_METHOD(void, check_alert, (), (const, override));
+    };
+
+    struct ValueShard {
+        size_t operator()(const TestEvent &event) const {
+            return static_cast<size_t>(event.value);
+        }
+    };
+}
+
+TEST(ShardedEventProcessorTest, ShouldRejectShardIndexOutOfRange) {
+    MockSequenceBarrier barrier;
+    RingBuffer<TestEvent, BUFFER_SIZE> ring_buffer(createTestEvent);
+
+    EXPECT_THROW((ShardedEventProcessor<TestEvent, BUFFER_SIZE, ValueShard>(
+                     barrier, [](TestEvent &, size_t, bool) {}, ring_buffer, ValueShard{}, 3, 3)),
+                 std::invalid_argument);
+}
+
+TEST(ShardedEventProcessorTest, ShouldHandleOnlyItsShardAndFlagTheLastOneOfTheBatch) {
+    MockSequenceBarrier barrier;
+    RingBuffer<TestEvent, BUFFER_SIZE> ring_buffer(createTestEvent);
+    for (size_t i = 0; i < BUFFER_SIZE; ++i) {
+        ring_buffer.get(i).value = static_cast<long>(i);
+    }
+
+    std::vector<size_t> handled;
+    std::vector<size_t> batch_ends;
+    ShardedEventProcessor<TestEvent, BUFFER_SIZE, ValueShard> processor(
+        barrier, [&](const TestEvent &, const size_t sequence, const bool end_of_batch) {
+            handled.push_back(sequence);
+            if (end_of_batch) {
+                batch_ends.push_back(sequence);
+            }
+        }, ring_buffer, ValueShard{}, 2, 3);
+
+    // batch [17, 22] holds values 1..6: shard 2 gets 2 and 5, the batch ends on a sequence of another shard
+    EXPECT_CALL(barrier, clear_alert()).Times(1);
+    EXPECT_CALL(barrier, wait_for(BUFFER_SIZE + 1)).WillOnce(Return(BUFFER_SIZE + 6));
+    // batch [23, 23] holds value 7: nothing for shard 2, the sequence is still released
+    EXPECT_CALL(barrier, wait_for(BUFFER_SIZE + 7)).WillOnce(Return(BUFFER_SIZE + 7));
+    EXPECT_CALL(barrier, wait_for(BUFFER_SIZE + 8)).WillOnce(Throw(AlertException()));
+
+    processor.run();
+
+    EXPECT_THAT(handled, ElementsAre(BUFFER_SIZE + 2, BUFFER_SIZE + 5));
+    EXPECT_THAT(batch_ends, ElementsAre(BUFFER_SIZE + 5));
+    EXPECT_EQ(processor.get_cursor().get_with_acquire(), BUFFER_SIZE + 7);
+}
+
+TEST(ShardedProcessorGroupTest, EachKeyShouldBeHandledInOrderByOneShard) {
+    constexpr size_t RING_SIZE = 64;
+    constexpr size_t NUM_EVENTS = 20'000;
+    constexpr size_t NUM_KEYS = 10;
+    constexpr size_t NUM_SHARDS = 3;
+
+    RingBuffer<TestEvent, RING_SIZE> ring_buffer(createTestEvent);
+    SingleProducerSequencer<TestEvent, RING_SIZE, 1> sequencer(ring_buffer);
+
+    // key in "value", per key counter in "message"
+    const auto by_key = [](const TestEvent &event) { return static_cast<size_t>(event.value); };
+
+    std::vector<std::vector<long> > last_counter(NUM_SHARDS, std::vector<long>(NUM_KEYS, -1));
+    std::atomic<size_t> total{0};
+    std::atomic<size_t> out_of_order{0};
+    std::vector<std::function<void(TestEvent &, size_t, bool)> > handlers;
+    for (size_t shard = 0; shard < NUM_SHARDS; ++shard) {
+        handlers.emplace_back([&, shard](const TestEvent &event, size_t, bool) {
+            const auto key = static_cast<size_t>(event.value);
+            const long counter = std::stol(event.message);
+            if (key % NUM_SHARDS != shard || counter != last_counter[shard][key] + 1) {
+                out_of_order.fetch_add(1, std::memory_order_relaxed);
+            }
+            last_counter[shard][key] = counter;
+            total.fetch_add(1, std::memory_order_release);
+        });
+    }
+
+    ShardedProcessorGroup<TestEvent, RING_SIZE, WaitStrategyType::ADAPTIVE, 1, decltype(by_key)> group(
+        ring_buffer, sequencer, true, {sequencer.get_cursor()}, by_key, handlers);
+    sequencer.add_gating_sequences({group.get_gating_sequence()});
+    ASSERT_EQ(group.size(), NUM_SHARDS);
+
+    std::vector<std::thread> threads = group.start();
+
+    std::vector<long> counters(NUM_KEYS, 0);
+    for (size_t i = 0; i < NUM_EVENTS; ++i) {
+        const size_t key = (i * 7) % NUM_KEYS;
+        const size_t claimed = sequencer.next(1);
+        TestEvent &event = ring_buffer.get(claimed);
+        event.value = static_cast<long>(key);
+        event.message = std::to_string(counters[key]++);
+        sequencer.publish(claimed);
+    }
+
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    const size_t last_published = sequencer.get_cursor().get_with_acquire();
+    while (group.get_gating_sequence().get_with_acquire() < last_published
+           && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    group.halt();
+    for (auto &thread: threads) {
+        thread.join();
+    }
+
+    EXPECT_EQ(total.load(), NUM_EVENTS);
+    EXPECT_EQ(out_of_order.load(), 0);
+    EXPECT_EQ(group.get_gating_sequence().get_with_acquire(), last_published);
+}
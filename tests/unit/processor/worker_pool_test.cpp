@@ -0,0 +1,132 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "WorkerPool.hpp"
+#include "BatchEventProcessor.hpp"
+#include "ProcessingSequenceBarrier.hpp"
+#include "RingBuffer.hpp"
+#include "SingleProducerSequencer.hpp"
+#include "MultiProducerSequencer.hpp"
+#include "TestEvent.hpp"
+
+using namespace disruptor;
+
+namespace {
+    constexpr size_t BUFFER_SIZE = 64;
+
+    void wait_until(const std::function<bool()> &condition) {
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+        while (!condition() && std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+}
+
+TEST(WorkerPoolTest, ShouldRejectEmptyPool) {
+    RingBuffer<TestEvent, BUFFER_SIZE> ring_buffer(createTestEvent);
+    SingleProducerSequencer<TestEvent, BUFFER_SIZE, 1> sequencer(ring_buffer);
+
+    EXPECT_THROW((WorkerPool<TestEvent, BUFFER_SIZE, WaitStrategyType::ADAPTIVE, 1>(
+                     ring_buffer, sequencer, true, {sequencer.get_cursor()},
+                     [](TestEvent &, size_t) {}, 0)),
+                 std::invalid_argument);
+}
+
+TEST(WorkerPoolTest, EachEventShouldBeHandledByExactlyOneWorker) {
+    constexpr size_t NUM_EVENTS = 20'000;
+    constexpr size_t NUM_WORKERS = 4;
+
+    RingBuffer<TestEvent, BUFFER_SIZE> ring_buffer(createTestEvent);
+    SingleProducerSequencer<TestEvent, BUFFER_SIZE, 1> sequencer(ring_buffer);
+
+    std::vector<std::atomic<int> > handled(NUM_EVENTS);
+    std::atomic<size_t> total{0};
+    WorkerPool<TestEvent, BUFFER_SIZE, WaitStrategyType::ADAPTIVE, 1> pool(
+        ring_buffer, sequencer, true, {sequencer.get_cursor()},
+        [&](const TestEvent &event, size_t) {
+            handled[event.value].fetch_add(1, std::memory_order_relaxed);
+            total.fetch_add(1, std::memory_order_release);
+        },
+        NUM_WORKERS);
+    sequencer.add_gating_sequences({pool.get_gating_sequence()});
+
+    std::vector<std::thread> threads = pool.start();
+    ASSERT_EQ(threads.size(), NUM_WORKERS);
+
+    size_t last_published = 0;
+    for (size_t i = 0; i < NUM_EVENTS; ++i) {
+        last_published = sequencer.next(1);
+        ring_buffer.get(last_published).value = static_cast<long>(i);
+        sequencer.publish(last_published);
+    }
+
+    wait_until([&] { return total.load(std::memory_order_acquire) == NUM_EVENTS; });
+    // every worker has claimed the next (unpublished) event, so the pool is released up to the last event
+    wait_until([&] { return pool.get_gating_sequence().get_with_acquire() == last_published; });
+    pool.halt();
+    for (auto &thread: threads) {
+        thread.join();
+    }
+
+    EXPECT_EQ(total.load(), NUM_EVENTS);
+    for (size_t i = 0; i < NUM_EVENTS; ++i) {
+        ASSERT_EQ(handled[i].load(), 1) << "event " << i;
+    }
+    EXPECT_EQ(pool.get_gating_sequence().get_with_acquire(), last_published);
+}
+
+TEST(WorkerPoolTest, DownstreamProcessorShouldSeeEventsAfterThePool) {
+    constexpr size_t NUM_EVENTS = 5'000;
+
+    RingBuffer<TestEvent, BUFFER_SIZE> ring_buffer(createTestEvent);
+    MultiProducerSequencer<TestEvent, BUFFER_SIZE, 1> sequencer(ring_buffer);
+
+    WorkerPool<TestEvent, BUFFER_SIZE, WaitStrategyType::YIELD, 1> pool(
+        ring_buffer, sequencer, true, {sequencer.get_cursor()},
+        [](TestEvent &event, size_t) { event.message = "worked"; },
+        3);
+
+    // a single barrier can't be shared, the downstream processor gets its own on the pool
+    ProcessingSequenceBarrier<WaitStrategyType::YIELD, 1> barrier(false, {pool.get_gating_sequence()}, sequencer);
+    std::atomic<size_t> seen{0};
+    std::atomic<size_t> not_worked{0};
+    BatchEventProcessor<TestEvent, BUFFER_SIZE> processor(barrier, [&](const TestEvent &event, size_t, bool) {
+        if (event.message != "worked") {
+            not_worked.fetch_add(1, std::memory_order_relaxed);
+        }
+        seen.fetch_add(1, std::memory_order_release);
+    }, ring_buffer);
+    sequencer.add_gating_sequences({processor.get_cursor()});
+
+    std::vector<std::thread> threads = pool.start();
+    std::thread processor_thread([&processor] { processor.run(); });
+
+    std::vector<std::thread> producers;
+    for (int p = 0; p < 2; ++p) {
+        producers.emplace_back([&] {
+            for (size_t i = 0; i < NUM_EVENTS / 2; ++i) {
+                const size_t claimed = sequencer.next(1);
+                ring_buffer.get(claimed).message = "published";
+                sequencer.publish(claimed);
+            }
+        });
+    }
+    for (auto &producer: producers) {
+        producer.join();
+    }
+
+    wait_until([&] { return seen.load(std::memory_order_acquire) == NUM_EVENTS; });
+    processor.halt();
+    pool.halt();
+    processor_thread.join();
+    for (auto &thread: threads) {
+        thread.join();
+    }
+
+    EXPECT_EQ(seen.load(), NUM_EVENTS);
+    EXPECT_EQ(not_worked.load(), 0);
+}
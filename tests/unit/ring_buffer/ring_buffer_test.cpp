@@ -61,3 +61,63 @@ TEST_F(RingBufferTest, ShouldWrapAroundTheBuffer) {
     // Ensure they are the same object by checking their memory address
     ASSERT_EQ(&ringBuffer.get(sequence), &wrappedEvent);
 }
+
+TEST_F(RingBufferTest, ShouldSplitRangeAtTheWrapPoint) {
+    // fits before the end of the buffer: one span
+    const auto [first, second] = ringBuffer.get_range(BUFFER_SIZE + 2, BUFFER_SIZE + 5);
+    ASSERT_EQ(first.size(), 4);
+    ASSERT_EQ(first.data(), &ringBuffer.get(2));
+    ASSERT_TRUE(second.empty());
+
+    // wraps: the tail of the buffer, then its head
+    const auto [tail, head] = ringBuffer.get_range(BUFFER_SIZE * 3 - 3, BUFFER_SIZE * 3 + 1);
+    ASSERT_EQ(tail.size(), 3);
+    ASSERT_EQ(tail.data(), &ringBuffer.get(BUFFER_SIZE - 3));
+    ASSERT_EQ(head.size(), 2);
+    ASSERT_EQ(head.data(), &ringBuffer.get(0));
+
+    // the whole buffer
+    const auto [all, none] = ringBuffer.get_range(BUFFER_SIZE, BUFFER_SIZE * 2 - 1);
+    ASSERT_EQ(all.size(), BUFFER_SIZE);
+    ASSERT_TRUE(none.empty());
+}
+
+class DynamicRingBufferTest : public testing::Test {
+protected:
+    static constexpr size_t BUFFER_SIZE = 1 << 12;
+    disruptor::RingBuffer<TestEvent, disruptor::DYNAMIC_SIZE> ringBuffer{BUFFER_SIZE, createTestEvent};
+};
+
+TEST_F(DynamicRingBufferTest, ShouldTakeBufferSizeAtRuntime) {
+    ASSERT_EQ(BUFFER_SIZE, ringBuffer.get_buffer_size());
+    ASSERT_EQ(ringBuffer.get(BUFFER_SIZE - 1).message, "Initial");
+}
+
+TEST_F(DynamicRingBufferTest, ShouldWrapAroundTheBuffer) {
+    ringBuffer.get(7).value = 42;
+    ASSERT_EQ(&ringBuffer.get(7), &ringBuffer.get(7 + BUFFER_SIZE * 3));
+    ASSERT_EQ(ringBuffer.get(7 + BUFFER_SIZE).value, 42);
+}
+
+TEST_F(DynamicRingBufferTest, ShouldRejectSizeThatIsNotPowerOfTwo) {
+    using DynamicRingBuffer = disruptor::RingBuffer<TestEvent, disruptor::DYNAMIC_SIZE>;
+    ASSERT_THROW(DynamicRingBuffer(0, createTestEvent), std::invalid_argument);
+    ASSERT_THROW(DynamicRingBuffer(1000, createTestEvent), std::invalid_argument);
+}
+
+TEST_F(DynamicRingBufferTest, ShouldFallBackWhenHugePagesAreNotReserved) {
+    // without vm.nr_hugepages the mapping falls back to normal pages instead of failing
+    disruptor::RingBuffer<TestEvent, disruptor::DYNAMIC_SIZE> hugeRingBuffer{
+        BUFFER_SIZE, createTestEvent, disruptor::PageSize::HUGE_2MB
+    };
+    hugeRingBuffer.get(BUFFER_SIZE - 1).value = 7;
+    ASSERT_EQ(hugeRingBuffer.get(BUFFER_SIZE * 2 - 1).value, 7);
+}
+
+TEST_F(DynamicRingBufferTest, ShouldSplitRangeAtTheWrapPoint) {
+    const auto [tail, head] = ringBuffer.get_range(BUFFER_SIZE - 1, BUFFER_SIZE + 4);
+    ASSERT_EQ(tail.size(), 1);
+    ASSERT_EQ(tail.data(), &ringBuffer.get(BUFFER_SIZE - 1));
+    ASSERT_EQ(head.size(), 5);
+    ASSERT_EQ(head.data(), &ringBuffer.get(0));
+}
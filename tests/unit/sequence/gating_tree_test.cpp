@@ -0,0 +1,86 @@
+#include <gtest/gtest.h>
+#include <deque>
+#include <thread>
+#include <vector>
+
+#include "GatingTree.hpp"
+
+using namespace disruptor;
+
+namespace {
+    std::vector<std::reference_wrapper<Sequence> > references(std::deque<Sequence> &sequences) {
+        return {sequences.begin(), sequences.end()};
+    }
+}
+
+TEST(GatingTreeTest, ShouldStartAtMinimumOfConsumers) {
+    std::deque<Sequence> consumers;
+    for (size_t i = 0; i < 20; ++i) {
+        consumers.emplace_back(100 + i);
+    }
+    consumers[13].set(42);
+
+    GatingTree tree(references(consumers), 4);
+
+    EXPECT_EQ(tree.get_root().get_with_acquire(), 42);
+    // 20 consumers -> 5 nodes -> 2 nodes -> root
+    EXPECT_EQ(tree.get_depth(), 3);
+}
+
+TEST(GatingTreeTest, ShouldUseSingleNodeForFewConsumers) {
+    std::deque<Sequence> consumers{Sequence(5), Sequence(7)};
+    GatingTree tree(references(consumers));
+
+    EXPECT_EQ(tree.get_depth(), 1);
+    EXPECT_EQ(&tree.get_parent_of(0).get_sequence(), &tree.get_root());
+}
+
+TEST(GatingTreeTest, ShouldPropagateWhenSlowestConsumerAdvances) {
+    std::deque<Sequence> consumers;
+    for (size_t i = 0; i < 9; ++i) {
+        consumers.emplace_back(10);
+    }
+    GatingTree tree(references(consumers), 3);
+
+    // every consumer but the last moves on: the root stays behind the slowest one
+    for (size_t i = 0; i < 8; ++i) {
+        consumers[i].set_with_release(50);
+        tree.get_parent_of(i).refresh();
+    }
+    EXPECT_EQ(tree.get_root().get_with_acquire(), 10);
+
+    consumers[8].set_with_release(30);
+    tree.get_parent_of(8).refresh();
+    EXPECT_EQ(tree.get_root().get_with_acquire(), 30);
+}
+
+TEST(GatingTreeTest, ShouldReachMinimumWhenConsumersRefreshConcurrently) {
+    constexpr size_t NUM_CONSUMERS = 32;
+    constexpr size_t NUM_STEPS = 20'000;
+    std::deque<Sequence> consumers;
+    for (size_t i = 0; i < NUM_CONSUMERS; ++i) {
+        consumers.emplace_back(0);
+    }
+    GatingTree tree(references(consumers), 4);
+
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < NUM_CONSUMERS; ++i) {
+        threads.emplace_back([&, i] {
+            for (size_t step = 1; step <= NUM_STEPS + i; ++step) {
+                consumers[i].set_with_release(step);
+                tree.get_parent_of(i).refresh();
+            }
+        });
+    }
+    for (auto &thread: threads) {
+        thread.join();
+    }
+
+    EXPECT_EQ(tree.get_root().get_with_acquire(), NUM_STEPS);
+}
+
+TEST(GatingTreeTest, ShouldRejectInvalidShape) {
+    std::deque<Sequence> consumers{Sequence(1)};
+    EXPECT_THROW(GatingTree({}, 4), std::invalid_argument);
+    EXPECT_THROW(GatingTree(references(consumers), 1), std::invalid_argument);
+}
@@ -64,3 +64,24 @@ TEST(SequenceGroupForMultiThreadTest, ShouldUpdateToNewMinimumWhenAllSequencesAd
 
     EXPECT_EQ(15, group.get());
 }
+
+TEST(SequenceGroupForMultiThreadTest, ShouldGatherMinimumOfWideGroup) {
+    std::array<disruptor::Sequence, 18> s;
+    for (size_t i = 0; i < s.size(); ++i) {
+        s[i].set_with_release(100 + i);
+    }
+    disruptor::SequenceGroupForMultiThread<18> group{
+        std::ref(s[0]), std::ref(s[1]), std::ref(s[2]), std::ref(s[3]), std::ref(s[4]), std::ref(s[5]),
+        std::ref(s[6]), std::ref(s[7]), std::ref(s[8]), std::ref(s[9]), std::ref(s[10]), std::ref(s[11]),
+        std::ref(s[12]), std::ref(s[13]), std::ref(s[14]), std::ref(s[15]), std::ref(s[16]), std::ref(s[17])
+    };
+    EXPECT_EQ(100, group.get());
+
+    // minimum in the scalar tail, then in a vector lane
+    s[0].set_with_release(200);
+    s[17].set_with_release(50);
+    EXPECT_EQ(50, group.get());
+    s[17].set_with_release(200);
+    s[9].set_with_release(60);
+    EXPECT_EQ(60, group.get());
+}
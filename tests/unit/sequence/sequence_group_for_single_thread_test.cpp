@@ -32,6 +32,13 @@ TEST_F(SequenceGroupForSingleThreadTestOne, ShouldUpdateCacheWhenSequenceChanges
     ASSERT_EQ(group.get_cache(), 15);
 }
 
+TEST_F(SequenceGroupForSingleThreadTestOne, ShouldPeekWithoutTouchingTheCache) {
+    static_cast<void>(group.get());
+    s1.set_with_release(15);
+    ASSERT_EQ(group.peek(), 15);
+    ASSERT_EQ(group.get_cache(), 10);
+}
+
 
 //----------MULTI SEQUENCE------------------
 class SequenceGroupForSingleThreadTest : public testing::Test {
@@ -63,6 +70,13 @@ TEST_F(SequenceGroupForSingleThreadTest, ShouldUpdateCacheWhenMinSequenceChanges
     ASSERT_EQ(group.get_cache(), 10);
 }
 
+TEST_F(SequenceGroupForSingleThreadTest, ShouldPeekWithoutTouchingTheCache) {
+    static_cast<void>(group.get());
+    s3.set_with_release(15);
+    ASSERT_EQ(group.peek(), 10);
+    ASSERT_EQ(group.get_cache(), 5);
+}
+
 TEST_F(SequenceGroupForSingleThreadTest, ShouldHandleSameSequenceValues) {
     s1.set_with_release(5);
     static_cast<void>(group.get());
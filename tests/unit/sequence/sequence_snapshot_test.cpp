@@ -0,0 +1,90 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <deque>
+#include <thread>
+
+#include "SequenceSnapshot.hpp"
+#include "SequenceGroupForMultiThread.hpp"
+#include "SequenceGroupForSingleThread.hpp"
+
+using namespace disruptor;
+
+TEST(SequenceSnapshotTest, ShouldReturnUpperBoundWhenEmpty) {
+    const SequenceSnapshot snapshot;
+    EXPECT_EQ(snapshot.size(), 0);
+    EXPECT_EQ(snapshot.minimum(77), 77);
+}
+
+TEST(SequenceSnapshotTest, ShouldAddAndRemoveSequences) {
+    SequenceSnapshot snapshot;
+    Sequence s1(10);
+    Sequence s2(20);
+
+    snapshot.add(s1);
+    snapshot.add(s2);
+    EXPECT_EQ(snapshot.size(), 2);
+    EXPECT_EQ(snapshot.minimum(100), 10);
+
+    EXPECT_TRUE(snapshot.remove(s1));
+    EXPECT_FALSE(snapshot.remove(s1));
+    EXPECT_EQ(snapshot.minimum(100), 20);
+
+    snapshot.set({std::ref(s1)});
+    EXPECT_EQ(snapshot.size(), 1);
+    EXPECT_EQ(snapshot.minimum(100), 10);
+}
+
+TEST(SequenceSnapshotTest, ReadersShouldNeverSeeRemovedOrTornSets) {
+    SequenceSnapshot snapshot;
+    Sequence slow(5);
+    Sequence fast(50);
+    snapshot.add(slow);
+
+    std::atomic<bool> running{true};
+    std::thread reader([&] {
+        while (running.load(std::memory_order_acquire)) {
+            const size_t minimum = snapshot.minimum(1000);
+            // "slow" is always present, so the minimum never goes above it
+            ASSERT_EQ(minimum, 5);
+        }
+    });
+
+    // concurrent writers churning the set
+    std::vector<std::thread> writers;
+    std::deque<Sequence> extra;
+    for (size_t i = 0; i < 4; ++i) {
+        extra.emplace_back(100 + i);
+    }
+    for (size_t i = 0; i < 4; ++i) {
+        writers.emplace_back([&, i] {
+            for (int round = 0; round < 2'000; ++round) {
+                snapshot.add(extra[i]);
+                snapshot.add(fast);
+                ASSERT_TRUE(snapshot.remove(extra[i]));
+                snapshot.remove(fast);
+            }
+        });
+    }
+    for (auto &writer: writers) {
+        writer.join();
+    }
+    running.store(false, std::memory_order_release);
+    reader.join();
+
+    EXPECT_EQ(snapshot.minimum(1000), 5);
+}
+
+TEST(SequenceSnapshotTest, DynamicGroupsShouldBoundMinimumByCursor) {
+    SequenceGroupForSingleThread<DYNAMIC_SIZE> single;
+    SequenceGroupForMultiThread<DYNAMIC_SIZE> multi;
+    Sequence consumer(30);
+
+    EXPECT_EQ(single.get(40), 40);
+    EXPECT_EQ(single.get_cache(), 40);
+    EXPECT_EQ(multi.get(40), 40);
+
+    single.add(consumer);
+    multi.add(consumer);
+    EXPECT_EQ(single.get(40), 30);
+    EXPECT_EQ(multi.get(40), 30);
+}
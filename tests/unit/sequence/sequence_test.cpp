@@ -28,3 +28,11 @@ TEST(SequenceTest, ShouldGetAndAddRelax) {
     EXPECT_EQ(10, result);
     EXPECT_EQ(15, sequence.get_with_acquire());
 }
+
+TEST(SequenceTest, ShouldCompareAndSet) {
+    disruptor::Sequence sequence(10);
+    EXPECT_FALSE(sequence.compare_and_set(9, 20));
+    EXPECT_EQ(10, sequence.get_with_acquire());
+    EXPECT_TRUE(sequence.compare_and_set(10, 20));
+    EXPECT_EQ(20, sequence.get_with_acquire());
+}
@@ -1,4 +1,6 @@
 #include <gtest/gtest.h>
+#include <atomic>
+#include <thread>
 
 #include "MultiProducerSequencer.hpp"
 #include "RingBuffer.hpp"
@@ -194,3 +196,107 @@ TEST_F(MultiProducerSequencerTest, ShouldProvideUniqueSequencesWithMultipleThrea
 
     ASSERT_EQ(gatingSequence.get_with_acquire(), highest_sequence);
 }
+
+TEST(DynamicMultiProducerSequencerTest, ShouldUseRuntimeBufferSize) {
+    constexpr size_t bufferSize = 64;
+    disruptor::RingBuffer<TestEvent, disruptor::DYNAMIC_SIZE> ringBuffer{bufferSize, createTestEvent};
+    disruptor::MultiProducerSequencer<TestEvent, disruptor::DYNAMIC_SIZE, 1> sequencer{ringBuffer};
+    disruptor::Sequence gatingSequence{disruptor::Util::calculate_initial_value_sequence(bufferSize)};
+    sequencer.add_gating_sequences({std::ref(gatingSequence)});
+
+    EXPECT_EQ(sequencer.get_cursor().get(), bufferSize);
+    ASSERT_THROW(sequencer.next(bufferSize + 1), std::invalid_argument);
+
+    const size_t high = sequencer.next(bufferSize);
+    const size_t low = high - bufferSize + 1;
+    EXPECT_FALSE(sequencer.is_available(low));
+    sequencer.publish(low, high);
+    EXPECT_EQ(sequencer.get_highest_published_sequence(low, high), high);
+    // the slot of "low" one lap later is not published yet
+    EXPECT_FALSE(sequencer.is_available(low + bufferSize));
+}
+
+TEST(CompactAvailabilityTest, ShouldStoreOneWordPerSlot) {
+    constexpr size_t bufferSize = 1 << 12;
+    using Sequencer = disruptor::MultiProducerSequencer<TestEvent, bufferSize, 1>;
+    // flags plus a fixed amount of cursor, padding and gating state
+    EXPECT_LT(sizeof(Sequencer), bufferSize * sizeof(uint32_t) + 64 * disruptor::CACHE_LINE_SIZE);
+}
+
+TEST_F(MultiProducerSequencerTest, ShouldTellLapsApartInPackedFlags) {
+    const size_t first = sequencer.next(1);
+    sequencer.publish(first);
+    gatingSequence.set_with_release(first);
+
+    // same slot, next lap
+    const size_t high = sequencer.next(BUFFER_SIZE);
+    ASSERT_EQ(high, first + BUFFER_SIZE);
+    EXPECT_TRUE(sequencer.is_available(first));
+    EXPECT_FALSE(sequencer.is_available(high));
+
+    sequencer.publish(high);
+    EXPECT_TRUE(sequencer.is_available(high));
+    EXPECT_FALSE(sequencer.is_available(first));
+    EXPECT_EQ(sequencer.get_highest_published_sequence(first + 1, high), first);
+}
+
+TEST_F(MultiProducerSequencerTest, ShouldScanPublishedRangeAcrossRingWrap) {
+    // move the cursor so the next batch starts near the end of the ring
+    const size_t start = sequencer.next(BUFFER_SIZE - 3);
+    sequencer.publish(start - (BUFFER_SIZE - 3) + 1, start);
+    gatingSequence.set_with_release(start);
+
+    const size_t high = sequencer.next(BUFFER_SIZE);
+    const size_t low = start + 1;
+    const size_t gap = low + 20; // past the wrap, several vectors in
+    sequencer.publish(low, gap - 1);
+    sequencer.publish(gap + 1, high);
+
+    EXPECT_EQ(sequencer.get_highest_published_sequence(low, high), gap - 1);
+    sequencer.publish(gap);
+    EXPECT_EQ(sequencer.get_highest_published_sequence(low, high), high);
+}
+
+TEST_F(MultiProducerSequencerTest, ShouldOnlyReadGatingSequencesWhenCacheIsBehind) {
+    const size_t initialValue = disruptor::Util::calculate_initial_value_sequence(BUFFER_SIZE);
+
+    // the whole first lap fits behind the initial cache
+    sequencer.next(BUFFER_SIZE);
+
+    // the consumer catches up, the next claim wraps past the cache and refreshes it
+    gatingSequence.set_with_release(initialValue + BUFFER_SIZE);
+    sequencer.next(1);
+
+    // claims that stay within the cached lap never look at the consumer again, even if it were behind
+    gatingSequence.set_with_release(initialValue);
+    sequencer.next(BUFFER_SIZE - 1);
+    EXPECT_EQ(sequencer.get_cursor().get_with_acquire(), initialValue + BUFFER_SIZE * 2);
+}
+
+TEST(DynamicGatingMultiProducerSequencerTest, ShouldGateOnConsumersAddedWhileRunning) {
+    constexpr size_t bufferSize = 16;
+    disruptor::RingBuffer<TestEvent, bufferSize> ringBuffer{createTestEvent};
+    disruptor::MultiProducerSequencer<TestEvent, bufferSize, disruptor::DYNAMIC_SIZE> sequencer{ringBuffer};
+
+    for (size_t i = 0; i < bufferSize * 3; ++i) {
+        sequencer.publish(sequencer.next(1));
+    }
+
+    disruptor::Sequence consumer;
+    sequencer.add_gating_sequence(consumer);
+    EXPECT_EQ(consumer.get(), sequencer.get_cursor().get());
+    sequencer.publish(sequencer.next(bufferSize));
+
+    std::atomic<bool> claimed{false};
+    std::thread producer([&] {
+        sequencer.publish(sequencer.next(1));
+        claimed = true;
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_FALSE(claimed.load());
+
+    // the consumer processes one event, freeing one slot
+    consumer.set_with_release(consumer.get() + 1);
+    producer.join();
+    EXPECT_TRUE(claimed.load());
+}
@@ -1,6 +1,7 @@
 #include <gtest/gtest.h>
 #include <thread>
 #include <chrono>
+#include <atomic>
 
 #include "RingBuffer.hpp"
 #include "SingleProducerSequencer.hpp"
@@ -128,3 +129,59 @@ TEST_F(SingleProducerSequencerTest, ShouldFailWhenAccessedByMultipleThreads) {
     // chết với thông báo lỗi mong muốn không.
     EXPECT_DEATH(multi_threaded_access(), "Accessed by two threads - use ProducerType.MULTI!");
 }
+
+TEST(DynamicSingleProducerSequencerTest, ShouldUseRuntimeBufferSize) {
+    constexpr size_t bufferSize = 128;
+    disruptor::RingBuffer<TestEvent, disruptor::DYNAMIC_SIZE> ringBuffer{bufferSize, createTestEvent};
+    disruptor::SingleProducerSequencer<TestEvent, disruptor::DYNAMIC_SIZE, 1> sequencer{ringBuffer};
+    disruptor::Sequence gatingSequence{disruptor::Util::calculate_initial_value_sequence(bufferSize)};
+    sequencer.add_gating_sequences({std::ref(gatingSequence)});
+
+    EXPECT_EQ(sequencer.get_cursor().get(), bufferSize);
+    const size_t sequence = sequencer.next(bufferSize);
+    EXPECT_EQ(sequence, bufferSize * 2);
+    sequencer.publish(sequence);
+    EXPECT_TRUE(sequencer.is_available(bufferSize + 1));
+}
+
+TEST(DynamicGatingSingleProducerSequencerTest, ShouldAttachAndDetachConsumersWhileRunning) {
+    constexpr size_t bufferSize = 16;
+    // static: the producer thread assertion keys on the address, a stack slot reused from another test would trip it
+    static disruptor::RingBuffer<TestEvent, bufferSize> ringBuffer{createTestEvent};
+    static disruptor::SingleProducerSequencer<TestEvent, bufferSize, disruptor::DYNAMIC_SIZE> sequencer{ringBuffer};
+    disruptor::Sequence consumer;
+
+    std::atomic<bool> attached{false};
+    std::atomic<bool> ready{false};
+    std::atomic<bool> claimed{false};
+    std::thread producer([&] {
+        // no consumer: the producer is only bounded by itself
+        for (size_t i = 0; i < bufferSize * 3; ++i) {
+            sequencer.publish(sequencer.next(1));
+        }
+        ready = true;
+        while (!attached) {
+            std::this_thread::yield();
+        }
+
+        // one lap ahead of the new consumer, then the ring is full
+        sequencer.publish(sequencer.next(bufferSize));
+        sequencer.publish(sequencer.next(1));
+        claimed = true;
+    });
+
+    while (!ready) {
+        std::this_thread::yield();
+    }
+    sequencer.add_gating_sequence(consumer);
+    EXPECT_EQ(consumer.get(), sequencer.get_cursor().get());
+    attached = true;
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_FALSE(claimed.load());
+
+    EXPECT_TRUE(sequencer.remove_gating_sequence(consumer));
+    producer.join();
+    EXPECT_TRUE(claimed.load());
+    EXPECT_FALSE(sequencer.remove_gating_sequence(consumer));
+}
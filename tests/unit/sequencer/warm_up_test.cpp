@@ -0,0 +1,41 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <thread>
+
+#include "MultiProducerSequencer.hpp"
+#include "RingBuffer.hpp"
+#include "SingleProducerSequencer.hpp"
+#include "WarmUp.hpp"
+#include "TestEvent.hpp"
+
+using namespace disruptor;
+
+TEST(WarmUpTest, RunLapsShouldWaitUntilConsumersProcessedEveryEvent) {
+    constexpr size_t bufferSize = 64;
+    constexpr size_t laps = 3;
+    RingBuffer<TestEvent, bufferSize> ringBuffer{createTestEvent};
+    SingleProducerSequencer<TestEvent, bufferSize, 1> sequencer{ringBuffer};
+    Sequence consumerSequence{Util::calculate_initial_value_sequence(bufferSize)};
+    sequencer.add_gating_sequences({std::ref(consumerSequence)});
+
+    std::atomic<bool> running{true};
+    size_t synthetic_events = 0;
+    std::thread consumer([&] {
+        size_t next = consumerSequence.get() + 1;
+        while (running.load(std::memory_order_acquire)) {
+            const size_t available = sequencer.get_cursor().get_with_acquire();
+            for (; next <= available; ++next) {
+                synthetic_events += ringBuffer.get(next).value == -2;
+            }
+            consumerSequence.set_with_release(available);
+        }
+    });
+
+    WarmUp::run_laps(ringBuffer, sequencer, laps, [](TestEvent &event, size_t) { event.value = -2; });
+
+    // run_laps only returns once the consumer is done
+    EXPECT_EQ(consumerSequence.get_with_acquire(), bufferSize + laps * bufferSize);
+    running.store(false, std::memory_order_release);
+    consumer.join();
+    EXPECT_EQ(synthetic_events, laps * bufferSize);
+}
@@ -0,0 +1,59 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <thread>
+
+#include "ThreadFactory.hpp"
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+using namespace disruptor;
+
+TEST(ThreadFactoryTest, ShouldRunBodyOnNewThread) {
+    std::atomic<bool> executed{false};
+    std::thread::id body_thread_id;
+
+    std::thread thread = ThreadFactory::create({}, [&] {
+        body_thread_id = std::this_thread::get_id();
+        executed = true;
+    });
+    thread.join();
+
+    EXPECT_TRUE(executed);
+    EXPECT_NE(body_thread_id, std::this_thread::get_id());
+}
+
+#if defined(__linux__)
+TEST(ThreadFactoryTest, ShouldPinAndNameThreadBeforeRunningBody) {
+    int cpu = -1;
+    char name[16] = {};
+    cpu_set_t affinity;
+
+    std::thread thread = ThreadFactory::create({{0}, std::nullopt, "disruptor-test-thread"}, [&] {
+        cpu = sched_getcpu();
+        pthread_getname_np(pthread_self(), name, sizeof(name));
+        pthread_getaffinity_np(pthread_self(), sizeof(affinity), &affinity);
+    });
+    thread.join();
+
+    EXPECT_EQ(cpu, 0);
+    EXPECT_EQ(CPU_COUNT(&affinity), 1);
+    EXPECT_TRUE(CPU_ISSET(0, &affinity));
+    // Linux limits names to 15 characters
+    EXPECT_STREQ(name, "disruptor-test-");
+}
+
+TEST(ThreadFactoryTest, ShouldReportSettingsThatCannotBeApplied) {
+    bool applied = true;
+
+    std::thread thread = ThreadFactory::create({}, [&] {
+        // no such core
+        applied = ThreadFactory::apply_to_current_thread({{CPU_SETSIZE - 1}, std::nullopt, ""});
+    });
+    thread.join();
+
+    EXPECT_FALSE(applied);
+}
+#endif
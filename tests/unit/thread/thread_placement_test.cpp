@@ -0,0 +1,186 @@
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <fstream>
+#include <set>
+#include <unistd.h>
+
+#include "CpuTopology.hpp"
+#include "ThreadPlacement.hpp"
+#include "Sequence.hpp"
+
+using namespace disruptor;
+
+// Giả lập /sys/devices/system/cpu: 2 socket x 2 core x 2 SMT
+// cpu0-3: thread đầu tiên của (socket 0 core 0, socket 0 core 1, socket 1 core 0, socket 1 core 1), cpu4-7: SMT siblings
+class ThreadPlacementTest : public testing::Test {
+protected:
+    std::filesystem::path root;
+
+    static void write(const std::filesystem::path &path, const std::string &content) {
+        std::filesystem::create_directories(path.parent_path());
+        std::ofstream(path) << content << "\n";
+    }
+
+    void SetUp() override {
+        root = std::filesystem::temp_directory_path() / ("disruptor_topology_" + std::to_string(getpid()));
+        std::filesystem::remove_all(root);
+        write(root / "online", "0-7");
+
+        for (int cpu = 0; cpu < 8; ++cpu) {
+            const int package = (cpu % 4) / 2;
+            const int core = cpu % 2;
+            const int first_sibling = cpu % 4;
+            const std::filesystem::path cpu_path = root / ("cpu" + std::to_string(cpu));
+
+            write(cpu_path / "topology" / "physical_package_id", std::to_string(package));
+            write(cpu_path / "topology" / "core_id", std::to_string(core));
+            std::filesystem::create_directories(cpu_path / ("node" + std::to_string(package)));
+
+            write(cpu_path / "cache" / "index0" / "level", "1");
+            write(cpu_path / "cache" / "index0" / "type", "Data");
+            write(cpu_path / "cache" / "index0" / "shared_cpu_list",
+                  std::to_string(first_sibling) + "," + std::to_string(first_sibling + 4));
+            write(cpu_path / "cache" / "index1" / "level", "1");
+            write(cpu_path / "cache" / "index1" / "type", "Instruction");
+            write(cpu_path / "cache" / "index1" / "shared_cpu_list", std::to_string(cpu));
+            write(cpu_path / "cache" / "index2" / "level", "2");
+            write(cpu_path / "cache" / "index2" / "type", "Unified");
+            write(cpu_path / "cache" / "index2" / "shared_cpu_list",
+                  std::to_string(first_sibling) + "," + std::to_string(first_sibling + 4));
+            write(cpu_path / "cache" / "index3" / "level", "3");
+            write(cpu_path / "cache" / "index3" / "type", "Unified");
+            write(cpu_path / "cache" / "index3" / "shared_cpu_list", package == 0 ? "0-1,4-5" : "2-3,6-7");
+        }
+    }
+
+    void TearDown() override {
+        std::filesystem::remove_all(root);
+    }
+
+    [[nodiscard]] CpuTopology topology() const {
+        return CpuTopology::read(root);
+    }
+
+    static int cpu_of(const std::unordered_map<std::string, ThreadConfig> &plan, const std::string &name) {
+        EXPECT_EQ(plan.at(name).cpus.size(), 1);
+        return plan.at(name).cpus.front();
+    }
+};
+
+TEST_F(ThreadPlacementTest, ShouldParseCpuList) {
+    EXPECT_EQ(CpuTopology::parse_cpu_list("0-3,8,10-11"), (std::vector<int>{0, 1, 2, 3, 8, 10, 11}));
+    EXPECT_EQ(CpuTopology::parse_cpu_list("5"), (std::vector<int>{5}));
+    EXPECT_TRUE(CpuTopology::parse_cpu_list("").empty());
+}
+
+TEST_F(ThreadPlacementTest, ShouldReadTopologyFromSysfs) {
+    const CpuTopology cpu_topology = topology();
+    ASSERT_EQ(cpu_topology.get_cpus().size(), 8);
+
+    const CpuInfo &cpu_1 = cpu_topology.get_cpu(1);
+    const CpuInfo &cpu_5 = cpu_topology.get_cpu(5);
+    const CpuInfo &cpu_2 = cpu_topology.get_cpu(2);
+
+    // SMT siblings
+    EXPECT_EQ(cpu_1.core_id, cpu_5.core_id);
+    EXPECT_EQ(cpu_1.l2_id, cpu_5.l2_id);
+    // other socket
+    EXPECT_NE(cpu_1.core_id, cpu_2.core_id);
+    EXPECT_NE(cpu_1.llc_id, cpu_2.llc_id);
+    EXPECT_EQ(cpu_1.numa_node, 0);
+    EXPECT_EQ(cpu_2.numa_node, 1);
+    EXPECT_EQ(cpu_topology.get_numa_node_cpus(1), (std::vector<int>{2, 3, 6, 7}));
+}
+
+TEST_F(ThreadPlacementTest, ShouldKeepPipelineInOneCacheDomainOnPhysicalCores) {
+    Sequence producer_cursor, consumer_1, consumer_2;
+
+    ThreadPlacement placement(topology());
+    placement.add_producer("producer", producer_cursor);
+    placement.add_consumer("consumer-1", consumer_1, {producer_cursor});
+    placement.add_consumer("consumer-2", consumer_2, {consumer_1});
+    const auto plan = placement.plan();
+
+    const CpuTopology cpu_topology = topology();
+    const CpuInfo &producer = cpu_topology.get_cpu(cpu_of(plan, "producer"));
+    const CpuInfo &first = cpu_topology.get_cpu(cpu_of(plan, "consumer-1"));
+    const CpuInfo &second = cpu_topology.get_cpu(cpu_of(plan, "consumer-2"));
+
+    // 3 threads but only 2 physical cores per socket: same LLC, producer and first consumer on distinct cores
+    EXPECT_EQ(producer.llc_id, first.llc_id);
+    EXPECT_EQ(producer.llc_id, second.llc_id);
+    EXPECT_NE(producer.core_id, first.core_id);
+    EXPECT_EQ(plan.at("producer").name, "producer");
+}
+
+TEST_F(ThreadPlacementTest, ShouldPlaceIndependentPipelinesOnDifferentSockets) {
+    Sequence cursor_a, consumer_a, cursor_b, consumer_b;
+
+    ThreadPlacement placement(topology());
+    placement.add_producer("producer-a", cursor_a);
+    placement.add_consumer("consumer-a", consumer_a, {cursor_a});
+    placement.add_producer("producer-b", cursor_b);
+    placement.add_consumer("consumer-b", consumer_b, {cursor_b});
+    const auto plan = placement.plan();
+
+    const CpuTopology cpu_topology = topology();
+    const int llc_a = cpu_topology.get_cpu(cpu_of(plan, "producer-a")).llc_id;
+    const int llc_b = cpu_topology.get_cpu(cpu_of(plan, "producer-b")).llc_id;
+
+    EXPECT_EQ(llc_a, cpu_topology.get_cpu(cpu_of(plan, "consumer-a")).llc_id);
+    EXPECT_EQ(llc_b, cpu_topology.get_cpu(cpu_of(plan, "consumer-b")).llc_id);
+    EXPECT_NE(llc_a, llc_b);
+
+    std::set<int> used;
+    for (const auto &[name, config]: plan) {
+        used.insert(config.cpus.front());
+    }
+    EXPECT_EQ(used.size(), 4);
+}
+
+TEST_F(ThreadPlacementTest, ShouldSkipExcludedCpus) {
+    Sequence cursor, consumer;
+
+    ThreadPlacement placement(topology());
+    placement.exclude_cpus({0, 1, 4, 5});
+    placement.add_producer("producer", cursor);
+    placement.add_consumer("consumer", consumer, {cursor});
+    const auto plan = placement.plan();
+
+    EXPECT_EQ(topology().get_cpu(cpu_of(plan, "producer")).package_id, 1);
+    EXPECT_EQ(topology().get_cpu(cpu_of(plan, "consumer")).package_id, 1);
+}
+
+TEST_F(ThreadPlacementTest, ShouldNotShareExcludedCpusWhenCoresRunOut) {
+    // 6 thread cho 2 cpu còn lại: các thread dư dùng chung cpu 2 và 3, không bao giờ dùng cpu bị loại
+    std::vector<Sequence> cursors(6);
+
+    ThreadPlacement placement(topology());
+    placement.exclude_cpus({0, 1, 4, 5, 6, 7});
+    placement.add_producer("producer", cursors[0]);
+    for (size_t i = 1; i < cursors.size(); ++i) {
+        placement.add_consumer("consumer-" + std::to_string(i), cursors[i], {cursors[i - 1]});
+    }
+    const auto plan = placement.plan();
+
+    ASSERT_EQ(plan.size(), cursors.size());
+    for (const auto &[name, config]: plan) {
+        ASSERT_EQ(config.cpus.size(), 1);
+        EXPECT_TRUE(config.cpus.front() == 2 || config.cpus.front() == 3) << name << " on cpu " << config.cpus.front();
+    }
+}
+
+TEST_F(ThreadPlacementTest, ShouldRejectPlanWhenEveryCpuIsExcluded) {
+    Sequence cursor;
+    ThreadPlacement placement(topology());
+    placement.exclude_cpus({0, 1, 2, 3, 4, 5, 6, 7});
+    placement.add_producer("producer", cursor);
+    EXPECT_THROW(static_cast<void>(placement.plan()), std::invalid_argument);
+}
+
+TEST_F(ThreadPlacementTest, ShouldRejectDuplicateNames) {
+    Sequence cursor;
+    ThreadPlacement placement(topology());
+    placement.add_producer("producer", cursor);
+    EXPECT_THROW(placement.add_producer("producer", cursor), std::invalid_argument);
+}
@@ -0,0 +1,119 @@
+#include <gtest/gtest.h>
+#include <thread>
+#include <chrono>
+
+#include "ProcessingSequenceBarrier.hpp"
+#include "SingleProducerSequencer.hpp"
+#include "RingBuffer.hpp"
+#include "AlertException.hpp"
+#include "TimeoutException.hpp"
+#include "WaitStrategyType.hpp"
+#include "TestEvent.hpp"
+
+using namespace disruptor;
+
+class BlockingWaitStrategyTest : public testing::Test {
+protected:
+    static constexpr size_t BUFFER_SIZE = 16;
+
+    RingBuffer<TestEvent, BUFFER_SIZE> ring_buffer{createTestEvent};
+    SingleProducerSequencer<TestEvent, BUFFER_SIZE, 1> sequencer{ring_buffer};
+    Sequence gating_sequence{Util::calculate_initial_value_sequence(BUFFER_SIZE)};
+
+    void SetUp() override {
+        sequencer.add_gating_sequences({std::ref(gating_sequence)});
+    }
+
+    // wait until the consumer has parked on the futex
+    void wait_for_parked_consumer() {
+        while (sequencer.get_blocking_signal().get_waiters() == 0) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+};
+
+TEST_F(BlockingWaitStrategyTest, ShouldReturnImmediatelyWhenSequenceIsAvailable) {
+    ProcessingSequenceBarrier<WaitStrategyType::BLOCKING, 1> barrier(true, {sequencer.get_cursor()}, sequencer);
+
+    const size_t sequence = sequencer.next(1);
+    sequencer.publish(sequence);
+
+    EXPECT_EQ(barrier.wait_for(sequence), sequence);
+    EXPECT_EQ(sequencer.get_blocking_signal().get_waiters(), 0);
+}
+
+TEST_F(BlockingWaitStrategyTest, ShouldWakeParkedConsumerOnPublish) {
+    ProcessingSequenceBarrier<WaitStrategyType::BLOCKING, 1> barrier(true, {sequencer.get_cursor()}, sequencer);
+    barrier.get_wait_strategy().set_park_timeout(std::chrono::seconds(10));
+    const size_t expected_sequence = Util::calculate_initial_value_sequence(BUFFER_SIZE) + 1;
+    const auto start = std::chrono::steady_clock::now();
+
+    // publish from another thread without claiming, the producer thread assertion is bound to the main thread
+    std::thread producer_thread([&] {
+        wait_for_parked_consumer();
+        sequencer.publish(expected_sequence);
+    });
+
+    EXPECT_EQ(barrier.wait_for(expected_sequence), expected_sequence);
+    // the park is bounded by 10s, so returning quickly means the publish woke us up
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(5));
+    producer_thread.join();
+}
+
+TEST_F(BlockingWaitStrategyTest, ShouldNotParkBehindAnotherProcessor) {
+    disruptor::Sequence processor_sequence{Util::calculate_initial_value_sequence(BUFFER_SIZE)};
+    ProcessingSequenceBarrier<WaitStrategyType::BLOCKING, 1> barrier(false, {std::ref(processor_sequence)}, sequencer);
+    barrier.get_wait_strategy().set_park_timeout(std::chrono::seconds(10));
+
+    const size_t sequence = sequencer.next(1);
+    sequencer.publish(sequence);
+
+    // the other processor never signals: a consumer parked on the futex would sleep for the whole timeout
+    std::thread processor_thread([&] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        processor_sequence.set_with_release(sequence);
+    });
+
+    const auto start = std::chrono::steady_clock::now();
+    EXPECT_EQ(barrier.wait_for(sequence), sequence);
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(5));
+    EXPECT_EQ(sequencer.get_blocking_signal().get_waiters(), 0);
+    processor_thread.join();
+}
+
+TEST_F(BlockingWaitStrategyTest, ShouldWakeParkedConsumerOnAlert) {
+    ProcessingSequenceBarrier<WaitStrategyType::BLOCKING, 1> barrier(true, {sequencer.get_cursor()}, sequencer);
+    const size_t expected_sequence = Util::calculate_initial_value_sequence(BUFFER_SIZE) + 1;
+
+    std::thread alert_thread([&] {
+        wait_for_parked_consumer();
+        barrier.alert();
+    });
+
+    EXPECT_THROW(static_cast<void>(barrier.wait_for(expected_sequence)), AlertException);
+    alert_thread.join();
+}
+
+TEST_F(BlockingWaitStrategyTest, ShouldNotSignalWithoutParkedConsumers) {
+    BlockingSignal &signal = sequencer.get_blocking_signal();
+    const uint32_t epoch = signal.get_epoch();
+
+    for (size_t i = 0; i < BUFFER_SIZE; ++i) {
+        const size_t sequence = sequencer.next(1);
+        sequencer.publish(sequence);
+    }
+
+    // no consumer parked: the producer never went through signal_all() and its wake syscall
+    EXPECT_EQ(signal.get_epoch(), epoch);
+    EXPECT_EQ(signal.get_waiters(), 0);
+}
+
+TEST_F(BlockingWaitStrategyTest, ShouldNotParkPastTheDeadline) {
+    ProcessingSequenceBarrier<WaitStrategyType::BLOCKING, 1> barrier(true, {sequencer.get_cursor()}, sequencer);
+    const size_t expected_sequence = Util::calculate_initial_value_sequence(BUFFER_SIZE) + 1;
+
+    const auto start = std::chrono::steady_clock::now();
+    EXPECT_THROW(static_cast<void>(barrier.wait_for(expected_sequence, start + std::chrono::milliseconds(20))),
+                 TimeoutException);
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(1));
+}
@@ -0,0 +1,68 @@
+#include <gtest/gtest.h>
+#include <thread>
+#include <chrono>
+
+#include "ProcessingSequenceBarrier.hpp"
+#include "SingleProducerSequencer.hpp"
+#include "RingBuffer.hpp"
+#include "TimeoutException.hpp"
+#include "WaitStrategyType.hpp"
+#include "TestEvent.hpp"
+
+using namespace disruptor;
+
+class PhasedBackoffWaitStrategyTest : public testing::Test {
+protected:
+    static constexpr size_t BUFFER_SIZE = 16;
+    static constexpr size_t FIRST_SEQUENCE = BUFFER_SIZE + 1;
+
+    RingBuffer<TestEvent, BUFFER_SIZE> ring_buffer{createTestEvent};
+    SingleProducerSequencer<TestEvent, BUFFER_SIZE, 1> sequencer{ring_buffer};
+};
+
+TEST_F(PhasedBackoffWaitStrategyTest, ShouldUseBarrierPolicy) {
+    constexpr BackoffPolicy policy{10, 5, std::chrono::microseconds(50), ParkMode::SLEEP};
+    ProcessingSequenceBarrier<WaitStrategyType::PHASED_BACKOFF, 1> barrier(
+        true, {sequencer.get_cursor()}, sequencer, policy);
+
+    EXPECT_EQ(barrier.get_wait_strategy().get_backoff_policy().spin_tries, 10);
+    EXPECT_EQ(barrier.get_wait_strategy().get_backoff_policy().yield_tries, 5);
+
+    std::thread producer_thread([&] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        sequencer.publish(FIRST_SEQUENCE);
+    });
+
+    EXPECT_EQ(barrier.wait_for(FIRST_SEQUENCE), FIRST_SEQUENCE);
+    producer_thread.join();
+}
+
+TEST_F(PhasedBackoffWaitStrategyTest, ShouldHandOffParkPhaseToBlockingSignal) {
+    constexpr BackoffPolicy policy{10, 1, std::chrono::seconds(10), ParkMode::BLOCK};
+    ProcessingSequenceBarrier<WaitStrategyType::PHASED_BACKOFF, 1> barrier(
+        true, {sequencer.get_cursor()}, sequencer, policy);
+
+    std::thread producer_thread([&] {
+        while (sequencer.get_blocking_signal().get_waiters() == 0) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        sequencer.publish(FIRST_SEQUENCE);
+    });
+
+    // the park is bounded by 10s, so returning quickly means the publish woke us up
+    const auto start = std::chrono::steady_clock::now();
+    EXPECT_EQ(barrier.wait_for(FIRST_SEQUENCE), FIRST_SEQUENCE);
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(5));
+    producer_thread.join();
+}
+
+TEST_F(PhasedBackoffWaitStrategyTest, ShouldStopAtDeadlineWhileParked) {
+    constexpr BackoffPolicy policy{1, 1, std::chrono::seconds(10), ParkMode::BLOCK};
+    ProcessingSequenceBarrier<WaitStrategyType::PHASED_BACKOFF, 1> barrier(
+        true, {sequencer.get_cursor()}, sequencer, policy);
+
+    const auto start = std::chrono::steady_clock::now();
+    EXPECT_THROW(static_cast<void>(barrier.wait_for(FIRST_SEQUENCE, start + std::chrono::milliseconds(20))),
+                 TimeoutException);
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(5));
+}
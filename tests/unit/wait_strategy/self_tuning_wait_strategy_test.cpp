@@ -0,0 +1,68 @@
+#include <gtest/gtest.h>
+#include <thread>
+#include <chrono>
+
+#include "ProcessingSequenceBarrier.hpp"
+#include "SelfTuningWaitStrategy.hpp"
+#include "SingleProducerSequencer.hpp"
+#include "RingBuffer.hpp"
+#include "WaitStrategyType.hpp"
+#include "TestEvent.hpp"
+
+using namespace disruptor;
+
+TEST(SelfTuningWaitStrategyTest, ShouldSpinLongerWhenEventsArriveQuickly) {
+    SelfTuningWaitStrategy<1> strategy{BackoffPolicy{}};
+
+    for (int i = 0; i < 100; ++i) {
+        strategy.observe(std::chrono::microseconds(10));
+    }
+
+    EXPECT_GT(strategy.get_backoff_policy().spin_tries, BackoffPolicy{}.spin_tries);
+    EXPECT_NEAR(strategy.get_average_wait().count(), std::chrono::nanoseconds(std::chrono::microseconds(10)).count(),
+                1000);
+}
+
+TEST(SelfTuningWaitStrategyTest, ShouldParkQuicklyWhenGapsAreLong) {
+    SelfTuningWaitStrategy<1> strategy{BackoffPolicy{}};
+
+    for (int i = 0; i < 100; ++i) {
+        strategy.observe(std::chrono::milliseconds(5));
+    }
+
+    EXPECT_LT(strategy.get_backoff_policy().spin_tries, BackoffPolicy{}.spin_tries);
+    EXPECT_LT(strategy.get_backoff_policy().yield_tries, BackoffPolicy{}.yield_tries);
+}
+
+TEST(SelfTuningWaitStrategyTest, ShouldRecoverWhenTrafficPicksUpAgain) {
+    SelfTuningWaitStrategy<1> strategy{BackoffPolicy{}};
+
+    for (int i = 0; i < 100; ++i) {
+        strategy.observe(std::chrono::milliseconds(5));
+    }
+    const int idle_spin_tries = strategy.get_backoff_policy().spin_tries;
+
+    for (int i = 0; i < 200; ++i) {
+        strategy.observe(std::chrono::microseconds(5));
+    }
+
+    EXPECT_GT(strategy.get_backoff_policy().spin_tries, idle_spin_tries);
+}
+
+TEST(SelfTuningWaitStrategyTest, ShouldWaitForSequenceThroughBarrier) {
+    constexpr size_t BUFFER_SIZE = 16;
+    RingBuffer<TestEvent, BUFFER_SIZE> ring_buffer{createTestEvent};
+    SingleProducerSequencer<TestEvent, BUFFER_SIZE, 1> sequencer{ring_buffer};
+    ProcessingSequenceBarrier<WaitStrategyType::SELF_TUNING, 1> barrier(true, {sequencer.get_cursor()}, sequencer);
+
+    std::thread producer_thread([&] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        sequencer.publish(BUFFER_SIZE + 1);
+    });
+
+    EXPECT_EQ(barrier.wait_for(BUFFER_SIZE + 1), BUFFER_SIZE + 1);
+    producer_thread.join();
+
+    // one 20ms gap is enough to pull the average above the spin window
+    EXPECT_GT(barrier.get_wait_strategy().get_average_wait(), std::chrono::microseconds(20));
+}